@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+/// Minimal helpers shared by the benchmarks: no framework, just wall-clock timing and a sink
+/// that keeps the optimizer from dropping the measured loop.
+
+inline volatile uint64_t bench_sink = 0;
+
+template<typename F>
+double measure_ns(F&& f, int repetitions = 5) {
+    double best = 0;
+    for (int i = 0; i != repetitions; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || elapsed < best) { best = elapsed; }
+    }
+    return best;
+}
+
+inline size_t bench_arg(int argc, char** argv, int i, size_t fallback) {
+    return argc > i ? std::strtoull(argv[i], nullptr, 10) : fallback;
+}
+
+/// xorshift: deterministic and cheap enough not to show up in the measurements
+struct bench_rng {
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    uint64_t operator()() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
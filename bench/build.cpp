@@ -0,0 +1,39 @@
+#include "bench.h"
+
+#include <unrolled_list.h>
+
+#include <numeric>
+#include <vector>
+
+/*
+    Cold-start bulk construction from a vector: the serial range constructor vs
+    unrolled_list(parallel_build, first, last). Each run builds a fresh list, so node allocation
+    is part of the measurement.
+
+    usage: build-bench [elements = 32M]
+*/
+
+template<size_t NodeMaxSize>
+void run(const std::vector<uint64_t>& values) {
+    double serial = measure_ns([&] {
+        unrolled_list<uint64_t, NodeMaxSize> list(values.begin(), values.end());
+        bench_sink = list.back();
+    }, 3);
+    double parallel = measure_ns([&] {
+        unrolled_list<uint64_t, NodeMaxSize> list(parallel_build, values.begin(), values.end());
+        bench_sink = list.back();
+    }, 3);
+    std::cout << "NodeMaxSize " << NodeMaxSize << ": serial " << serial / 1e6 << " ms, parallel " << parallel / 1e6
+              << " ms, speedup " << serial / parallel << "x\n";
+}
+
+int main(int argc, char** argv) {
+    size_t elements = bench_arg(argc, argv, 1, size_t{1} << 25);
+    std::vector<uint64_t> values(elements);
+    std::iota(values.begin(), values.end(), 0);
+    std::cout << elements << " elements, " << std::thread::hardware_concurrency() << " hardware threads\n";
+    run<16>(values);
+    run<64>(values);
+    run<256>(values);
+    return 0;
+}
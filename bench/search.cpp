@@ -0,0 +1,46 @@
+#include "bench.h"
+
+#include <unrolled_list.h>
+
+#include <algorithm>
+
+/*
+    find / count / min_element through the list's node-wise kernels vs the standard algorithms over
+    the element-by-element iterators. search-bench-scalar is the same program built with
+    UNROLLED_LIST_DISABLE_SIMD, so its "kernel" column is the plain per-node loop.
+
+    usage: search-bench [elements = 4M]
+*/
+
+constexpr size_t kNodeMaxSize = 64;
+
+template<typename T>
+void run(const char* name, size_t elements) {
+    unrolled_list<T, kNodeMaxSize> list;
+    bench_rng rng;
+    for (size_t i = 0; i != elements; ++i) { list.push_back(static_cast<T>(rng() % 100 + 1)); }
+    const auto& view = list;
+    const T absent = static_cast<T>(0);  // full scans
+
+    double find_kernel = measure_ns([&] { bench_sink = view.find(absent) == view.end(); });
+    double find_std = measure_ns([&] { bench_sink = std::find(view.begin(), view.end(), absent) == view.end(); });
+    double count_kernel = measure_ns([&] { bench_sink = view.count(static_cast<T>(7)); });
+    double count_std = measure_ns([&] { bench_sink = static_cast<uint64_t>(std::count(view.begin(), view.end(), static_cast<T>(7))); });
+    double min_kernel = measure_ns([&] { bench_sink = static_cast<uint64_t>(*view.min_element()); });
+    double min_std = measure_ns([&] { bench_sink = static_cast<uint64_t>(*std::min_element(view.begin(), view.end())); });
+
+    std::cout << name << " ns/element (kernel vs std):"
+              << " find " << find_kernel / elements << " vs " << find_std / elements
+              << ", count " << count_kernel / elements << " vs " << count_std / elements
+              << ", min " << min_kernel / elements << " vs " << min_std / elements << '\n';
+}
+
+int main(int argc, char** argv) {
+    size_t elements = bench_arg(argc, argv, 1, size_t{1} << 22);
+    run<int8_t>("int8  ", elements);
+    run<int32_t>("int32 ", elements);
+    run<int64_t>("int64 ", elements);
+    run<float>("float ", elements);
+    run<double>("double", elements);
+    return 0;
+}
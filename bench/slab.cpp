@@ -0,0 +1,48 @@
+#include "bench.h"
+
+#include <unrolled_list.h>
+#include <slab_allocator.h>
+
+/*
+    Iteration over a list built on a fragmented heap, std::allocator vs slab_allocator.
+    The heap is fragmented by allocating blocks of random size and freeing every other one before
+    the list is built, and by interleaving more junk allocations with the pushes themselves.
+
+    usage: slab-bench [elements = 16M]
+*/
+
+constexpr size_t kNodeMaxSize = 16;
+
+template<typename List>
+void run(const char* name, size_t elements) {
+    bench_rng rng;
+    size_t junk_size = elements / kNodeMaxSize + 1;
+    void** junk = new void*[junk_size * 2];
+    for (size_t i = 0; i != junk_size; ++i) { junk[i] = std::malloc(32 + rng() % 1024); }
+    for (size_t i = 0; i < junk_size; i += 2) { std::free(junk[i]); junk[i] = nullptr; }
+
+    List list;
+    size_t extra = junk_size;
+    double build = measure_ns([&] {
+        for (size_t i = 0; i != elements; ++i) {
+            if (i % kNodeMaxSize == 0) { junk[extra++] = std::malloc(32 + rng() % 1024); }
+            list.push_back(i);
+        }
+    }, 1);
+    double scan = measure_ns([&] {
+        uint64_t sum = 0;
+        for (auto iter = list.begin(); iter != list.end(); ++iter) { sum += *iter; }
+        bench_sink = sum;
+    }, 3);
+
+    std::cout << name << ": build " << build / elements << " ns/element, scan " << scan / elements << " ns/element\n";
+    for (size_t i = 0; i != extra; ++i) { std::free(junk[i]); }
+    delete[] junk;
+}
+
+int main(int argc, char** argv) {
+    size_t elements = bench_arg(argc, argv, 1, size_t{1} << 24);
+    run<unrolled_list<uint64_t, kNodeMaxSize>>("std::allocator ", elements);
+    run<unrolled_list<uint64_t, kNodeMaxSize, slab_allocator<uint64_t, 256>>>("slab_allocator ", elements);
+    return 0;
+}
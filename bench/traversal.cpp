@@ -0,0 +1,47 @@
+#include "bench.h"
+
+#include <unrolled_list.h>
+
+/*
+    Forward and backward scans of a list much larger than the last-level cache.
+    Between node allocations we allocate (and keep) junk blocks of random size, so consecutive
+    nodes are scattered over the heap like in a long-running process.
+
+    Built once per UNROLLED_LIST_PREFETCH_DISTANCE (see bench/CMakeLists.txt), compare the outputs.
+
+    usage: traversal-bench-pfN [elements = 64M]
+*/
+
+constexpr size_t kNodeMaxSize = 16;
+
+int main(int argc, char** argv) {
+    size_t elements = bench_arg(argc, argv, 1, size_t{1} << 26);
+
+    bench_rng rng;
+    unrolled_list<uint64_t, kNodeMaxSize> list;
+    void** junk = new void*[elements / kNodeMaxSize + 1];
+    size_t junk_count = 0;
+    for (size_t i = 0; i != elements; ++i) {
+        if (i % kNodeMaxSize == 0) { junk[junk_count++] = std::malloc(64 + rng() % 4096); }
+        list.push_back(i);
+    }
+
+    double forward = measure_ns([&] {
+        uint64_t sum = 0;
+        for (auto iter = list.begin(); iter != list.end(); ++iter) { sum += *iter; }
+        bench_sink = sum;
+    }, 3);
+    double backward = measure_ns([&] {
+        uint64_t sum = 0;
+        for (auto iter = list.rbegin(); iter != list.rend(); ++iter) { sum += *iter; }
+        bench_sink = sum;
+    }, 3);
+
+    std::cout << "prefetch distance " << UNROLLED_LIST_PREFETCH_DISTANCE << ", " << elements << " elements\n"
+              << "  forward:  " << forward / elements << " ns/element\n"
+              << "  backward: " << backward / elements << " ns/element\n";
+
+    for (size_t i = 0; i != junk_count; ++i) { std::free(junk[i]); }
+    delete[] junk;
+    return 0;
+}
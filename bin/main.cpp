@@ -1,37 +1,231 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include <sys/resource.h>
+
 #include <unrolled_list.h>
 
-template<typename T>
-class Allocator {
-public:
-    using value_type = T;
-    T* allocate(size_t size) {
-        T* ptr = static_cast<T*>(malloc(size * sizeof(T)));
-        std::cout << "allocate new item: " << ptr << "; size: " << size << '\n';
-        return ptr;
-    }
-    void deallocate(T* ptr, size_t size) {
-        std::cout << "deallocate memory: " << ptr << "\n";
-        free(ptr);
+/*
+    Workload trace replay: reads an operation trace, replays it against unrolled_list and reports
+    per-operation latency percentiles, throughput and peak memory.
+
+    usage: unrolled_list <trace> [--node-size N] [--element-size S] [--adaptive]
+
+    --adaptive replays with adaptive node capacity (see unrolled_list::set_adaptive_capacity()).
+
+    The trace is a text file with one operation per line ('#' starts a comment):
+        push_back <value>
+        push_front <value>
+        insert <position> <value>    insert before the element at position (position == size appends)
+        erase <position>
+        iterate                      read every element front to back
+        clear
+    Positional operations go through a cursor, so near-sequential positions are cheap, as they are
+    for real callers that keep one.
+*/
+
+constexpr std::array<size_t, 6> kNodeSizes = {8, 16, 32, 64, 128, 256};
+constexpr std::array<size_t, 4> kElementSizes = {4, 8, 16, 64};
+
+enum class op_kind { push_back, push_front, insert, erase, iterate, clear, count };
+
+constexpr std::array<const char*, static_cast<size_t>(op_kind::count)> kOpNames = {
+    "push_back", "push_front", "insert", "erase", "iterate", "clear",
+};
+
+struct operation {
+    op_kind kind;
+    uint64_t position = 0;
+    uint64_t value = 0;
+    size_t line = 0;
+};
+
+/// element of the given size whose leading bytes hold the traced value
+template<size_t Size>
+struct element {
+    element(uint64_t value) {
+        std::memset(bytes, 0, Size);
+        std::memcpy(bytes, &value, std::min(Size, sizeof(value)));
     }
+    unsigned char bytes[Size];
 };
 
-int main(int argc, char** argv) {
-    std::cout << "Hello, world!" << std::endl;
-    // unrolled_list<int, 1, Allocator<int>> list2 = {1, 2};
-    // list2.insert(++list2.begin(), {8, 9, 10, 11, 12, 13});
-    // unrolled_list<int, 5, Allocator<int>> list;
-    // for (int i = 0; i < 1000; ++i) {
-    //     list.push_back(i);
-    //     list.pop_front();
-    // }
-    // list.pop_front();
-    // for (auto iter = list.begin(); iter != list.end(); ++iter) {
-    //     std::cout << *iter << ' ';
-    // }
-
-    // std::cout << '\n' << list.size() << '\n';
+bool parse_trace(std::istream& in, std::vector<operation>& trace) {
+    std::string line;
+    for (size_t number = 1; std::getline(in, line); ++number) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string name;
+        if (!(fields >> name)) { continue; }
+
+        auto found = std::find_if(kOpNames.begin(), kOpNames.end(), [&](const char* op) { return name == op; });
+        if (found == kOpNames.end()) {
+            std::cerr << "line " << number << ": unknown operation '" << name << "'\n";
+            return false;
+        }
+        operation op{static_cast<op_kind>(found - kOpNames.begin()), 0, 0, number};
+        bool ok = true;
+        switch (op.kind) {
+            case op_kind::push_back:
+            case op_kind::push_front: ok = static_cast<bool>(fields >> op.value); break;
+            case op_kind::insert: ok = static_cast<bool>(fields >> op.position >> op.value); break;
+            case op_kind::erase: ok = static_cast<bool>(fields >> op.position); break;
+            default: break;
+        }
+        std::string rest;
+        if (!ok || fields >> rest) {
+            std::cerr << "line " << number << ": bad arguments for '" << name << "'\n";
+            return false;
+        }
+        trace.push_back(op);
+    }
+    return true;
+}
+
+size_t peak_rss_kib() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<size_t>(usage.ru_maxrss);  // KiB on Linux
+}
+
+template<size_t ElementSize, size_t NodeMaxSize>
+int replay(const std::vector<operation>& trace, bool adaptive) {
+    using value_type = element<ElementSize>;
+    using clock = std::chrono::steady_clock;
+
+    unrolled_list<value_type, NodeMaxSize> list;
+    list.set_adaptive_capacity(adaptive);
+    auto cursor = list.make_cursor();
+    std::array<std::vector<uint64_t>, kOpNames.size()> latencies;
+    size_t peak_capacity = 0;
+    uint64_t checksum = 0;
+
+    auto started = clock::now();
+    for (const operation& op : trace) {
+        if ((op.kind == op_kind::insert && op.position > list.size()) || (op.kind == op_kind::erase && op.position >= list.size())) {
+            std::cerr << "line " << op.line << ": position " << op.position << " is out of range (size " << list.size() << ")\n";
+            return 1;
+        }
+        auto op_started = clock::now();
+        switch (op.kind) {
+            case op_kind::push_back: list.push_back(op.value); break;
+            case op_kind::push_front: list.push_front(op.value); break;
+            case op_kind::insert: cursor.insert(op.position, op.value); break;
+            case op_kind::erase: cursor.erase(op.position); break;
+            case op_kind::iterate:
+                for (const value_type& value : std::as_const(list)) { checksum += value.bytes[0]; }
+                break;
+            case op_kind::clear: list.clear(); break;
+            default: break;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - op_started).count();
+        latencies[static_cast<size_t>(op.kind)].push_back(static_cast<uint64_t>(elapsed));
+
+        // changes made around the cursor invalidate it
+        if (op.kind == op_kind::push_back || op.kind == op_kind::push_front || op.kind == op_kind::clear) {
+            cursor = list.make_cursor();
+        }
+        peak_capacity = std::max(peak_capacity, list.capacity());
+    }
+    double total_ms = std::chrono::duration<double, std::milli>(clock::now() - started).count();
+
+    std::cout << "NodeMaxSize " << NodeMaxSize << (adaptive ? " (adaptive)" : "") << ", element size " << ElementSize << " bytes, "
+              << trace.size() << " operations\n\n";
+    std::cout << std::left << std::setw(12) << "operation" << std::right << std::setw(10) << "count";
+    for (const char* column : {"p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "max ns"}) {
+        std::cout << std::setw(11) << column;
+    }
+    std::cout << '\n';
+    for (size_t kind = 0; kind != latencies.size(); ++kind) {
+        std::vector<uint64_t>& samples = latencies[kind];
+        if (samples.empty()) { continue; }
+        std::sort(samples.begin(), samples.end());
+        std::cout << std::left << std::setw(12) << kOpNames[kind] << std::right << std::setw(10) << samples.size();
+        for (double quantile : {0.5, 0.9, 0.99, 0.999}) {
+            std::cout << std::setw(11) << samples[static_cast<size_t>(quantile * static_cast<double>(samples.size() - 1))];
+        }
+        std::cout << std::setw(11) << samples.back() << '\n';
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "\ntotal " << total_ms << " ms, " << static_cast<double>(trace.size()) / total_ms / 1000.0 << " Mops/s"
+              << " (timer overhead included)\n"
+              << "final size " << list.size() << ", peak capacity " << peak_capacity << " elements ("
+              << peak_capacity * ElementSize / 1024 << " KiB of element storage)\n"
+              << "peak RSS " << peak_rss_kib() << " KiB (the parsed trace included)\n"
+              << "checksum " << checksum << '\n';
     return 0;
 }
+
+template<size_t ElementSize, size_t... NodeSizeIndices>
+int dispatch_node_size(size_t node_size, const std::vector<operation>& trace, bool adaptive, std::index_sequence<NodeSizeIndices...>) {
+    int result = -1;
+    ((node_size == kNodeSizes[NodeSizeIndices] ? (result = replay<ElementSize, kNodeSizes[NodeSizeIndices]>(trace, adaptive), true) : false) || ...);
+    return result;
+}
+
+template<size_t... ElementSizeIndices>
+int dispatch(size_t element_size, size_t node_size, const std::vector<operation>& trace, bool adaptive, std::index_sequence<ElementSizeIndices...>) {
+    int result = -1;
+    ((element_size == kElementSizes[ElementSizeIndices]
+          ? (result = dispatch_node_size<kElementSizes[ElementSizeIndices]>(node_size, trace, adaptive, std::make_index_sequence<kNodeSizes.size()>()), true)
+          : false) || ...);
+    return result;
+}
+
+template<size_t N>
+void print_choices(const char* what, const std::array<size_t, N>& choices) {
+    std::cerr << what << " must be one of:";
+    for (size_t choice : choices) { std::cerr << ' ' << choice; }
+    std::cerr << '\n';
+}
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    size_t node_size = 16;
+    size_t element_size = 8;
+    bool adaptive = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "--node-size" || arg == "--element-size") && i + 1 < argc) {
+            (arg == "--node-size" ? node_size : element_size) = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--adaptive") {
+            adaptive = true;
+        } else if (path == nullptr && arg[0] != '-') {
+            path = argv[i];
+        } else {
+            path = nullptr;
+            break;
+        }
+    }
+    if (path == nullptr) {
+        std::cerr << "usage: " << argv[0] << " <trace> [--node-size N] [--element-size S] [--adaptive]\n";
+        return 2;
+    }
+
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "cannot open " << path << '\n';
+        return 2;
+    }
+    std::vector<operation> trace;
+    if (!parse_trace(in, trace)) { return 2; }
+
+    int result = dispatch(element_size, node_size, trace, adaptive, std::make_index_sequence<kElementSizes.size()>());
+    if (result == -1) {
+        print_choices("--node-size", kNodeSizes);
+        print_choices("--element-size", kElementSizes);
+        return 2;
+    }
+    return result;
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/// @brief the slab pools behind slab_allocator, one per slot shape (size and alignment), shared by
+/// an allocator, its copies and its rebound copies
+template<size_t SlabNodes>
+class slab_pool_set {
+    struct slab {
+        slab* prev;
+        slab* next;
+        void* free_list = nullptr;
+        size_t used = 0;
+        size_t fresh = 0;  // slots [fresh, capacity) were never handed out
+    };
+
+public:
+    /// @brief where the slots of a slab of slot_size-byte slots start, how large the slab is and how
+    /// many slots it has; a function of the slot alone, so every type with the same slot shares it
+    struct geometry {
+        size_t slot_size;
+        size_t slot_align;
+        size_t slots_offset;
+        size_t slab_bytes;
+        size_t slab_capacity;
+
+        static constexpr geometry of(size_t slot_size, size_t slot_align) {
+            size_t offset = (sizeof(slab) + slot_align - 1) / slot_align * slot_align;
+            size_t bytes = std::bit_ceil(offset + slot_size * SlabNodes);
+            return {slot_size, slot_align, offset, bytes, (bytes - offset) / slot_size};
+        }
+    };
+
+    /// @brief the slabs of one slot size
+    struct pool {
+        explicit pool(const geometry& g) : shape(g) {}
+        pool(const pool&) = delete;
+        pool& operator=(const pool&) = delete;
+
+        ~pool() {
+            while (partial != nullptr) {
+                slab* next = partial->next;
+                release(partial);
+                partial = next;
+            }
+        }
+
+        unsigned char* slots(slab* s) const { return reinterpret_cast<unsigned char*>(s) + shape.slots_offset; }
+        slab* owner(const void* p) const {
+            return reinterpret_cast<slab*>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t{shape.slab_bytes} - 1));
+        }
+        bool full(const slab* s) const { return s->free_list == nullptr && s->fresh == shape.slab_capacity; }
+
+        void link(slab* s) {
+            s->prev = nullptr;
+            s->next = partial;
+            if (partial != nullptr) { partial->prev = s; }
+            partial = s;
+        }
+        void unlink(slab* s) {
+            if (s->prev != nullptr) { s->prev->next = s->next; } else { partial = s->next; }
+            if (s->next != nullptr) { s->next->prev = s->prev; }
+        }
+        void release(slab* s) const {
+            s->~slab();
+            ::operator delete(s, std::align_val_t{shape.slab_bytes});
+        }
+
+        void* allocate(const void* hint) {
+            slab* s = hint != nullptr ? owner(hint) : nullptr;
+            if (s == nullptr || full(s)) { s = partial; }
+            if (s == nullptr) {
+                s = new (::operator new(shape.slab_bytes, std::align_val_t{shape.slab_bytes})) slab;
+                ++slabs;
+                link(s);
+            }
+            void* result;
+            if (s->free_list != nullptr) {
+                result = s->free_list;
+                s->free_list = *static_cast<void**>(result);
+            } else {
+                result = slots(s) + shape.slot_size * s->fresh++;
+            }
+            ++s->used;
+            if (full(s)) { unlink(s); }
+            return result;
+        }
+
+        void deallocate(void* p) {
+            slab* s = owner(p);
+            if (full(s)) { link(s); }
+            s->free_list = ::new (p) void*(s->free_list);
+            if (--s->used == 0) {
+                unlink(s);
+                release(s);
+                --slabs;
+            }
+        }
+
+        geometry shape;
+        slab* partial = nullptr;  // slabs with at least one free slot
+        size_t slabs = 0;
+    };
+
+    /// @brief the pool for slots of the given shape, created on first use
+    pool* find(const geometry& g) {
+        for (const std::unique_ptr<pool>& p : pools_) {
+            if (p->shape.slot_size == g.slot_size && p->shape.slot_align == g.slot_align) { return p.get(); }
+        }
+        return pools_.emplace_back(std::make_unique<pool>(g)).get();
+    }
+
+private:
+    std::vector<std::unique_ptr<pool>> pools_;
+};
+
+/// @brief allocator that carves single-object allocations out of contiguous slabs.
+///
+/// Meant as the Allocator of unrolled_list: the list rebinds it to its node type and passes the
+/// neighbouring node as the allocation hint, so a new node lands in the same slab as the node it is
+/// linked after whenever that slab has room. A slab is released as soon as its last object is freed.
+/// Each slab is aligned to its (power of two) size, so finding the slab of a pointer is a mask.
+///
+/// SlabNodes is the minimum number of objects per slab; the slab is rounded up to a power of two
+/// bytes and the slack is used for more objects. Requests for n != 1 objects bypass the slabs.
+///
+/// Copies and rebound copies share one set of pools, one pool per slot size, and compare equal;
+/// only default construction creates a new set. The pools are not thread-safe.
+template<typename T, size_t SlabNodes = 64>
+class slab_allocator {
+    static_assert(SlabNodes > 0, "SlabNodes must be greater than zero");
+
+    template<typename, size_t> friend class slab_allocator;
+
+    using pool_set = slab_pool_set<SlabNodes>;
+    using pool = typename pool_set::pool;
+
+    /// the storage of one object; a freed slot holds the free-list link instead
+    union slot {
+        void* next_free;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    static constexpr typename pool_set::geometry slot_geometry = pool_set::geometry::of(sizeof(slot), alignof(slot));
+
+public:
+    using value_type = T;
+    using pointer = T*;
+    using const_void_pointer = const void*;
+    using size_type = size_t;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    template<typename U>
+    struct rebind { using other = slab_allocator<U, SlabNodes>; };
+
+    slab_allocator() : pools_(std::make_shared<pool_set>()), pool_(pools_->find(slot_geometry)) {}
+    slab_allocator(const slab_allocator&) = default;
+    /// @brief shares the pools of other, so slab_allocator<T>(slab_allocator<U>(a)) == a
+    template<typename U>
+    slab_allocator(const slab_allocator<U, SlabNodes>& other) : pools_(other.pools_), pool_(pools_->find(slot_geometry)) {}
+    slab_allocator& operator=(const slab_allocator&) = default;
+
+    /// @param hint an object previously returned by this pool (or nullptr); the new object is placed
+    /// in the same slab when it has a free slot
+    pointer allocate(size_type n, const_void_pointer hint = nullptr) {
+        if (n != 1) { return static_cast<pointer>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)})); }
+        return static_cast<pointer>(pool_->allocate(hint));
+    }
+    void deallocate(pointer p, size_type n) {
+        if (n != 1) { ::operator delete(p, std::align_val_t{alignof(T)}); return; }
+        pool_->deallocate(p);
+    }
+
+    /// @brief number of slabs currently held by the pool of T's slot size
+    size_type slab_count() const { return pool_->slabs; }
+    /// @brief objects that fit in one slab
+    static constexpr size_type objects_per_slab() { return slot_geometry.slab_capacity; }
+
+    template<typename U>
+    bool operator==(const slab_allocator<U, SlabNodes>& rhs) const { return pools_ == rhs.pools_; }
+
+private:
+    std::shared_ptr<pool_set> pools_;
+    pool* pool_;
+};
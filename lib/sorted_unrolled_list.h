@@ -0,0 +1,265 @@
+#pragma once
+
+#include "unrolled_list.h"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/// @brief ordered sequence (duplicates allowed) on the nodes of unrolled_list, laid out like the
+/// leaf level of a B+-tree.
+///
+/// Next to the list it keeps a flat index with one pointer per node, in list order. The minimum key
+/// of a node is its first element, read in place, so a lookup is a binary search over the index and
+/// then one inside the node's data: O(log(n / NodeMaxSize) + log NodeMaxSize) comparisons and a
+/// couple of cache misses. Insert and erase shift elements of a single node and touch the index
+/// only when a node is split off or freed.
+///
+/// Elements are only reachable through const iterators: changing one in place could break the order.
+template<typename T, typename Compare = std::less<T>, size_t NodeMaxSize = 10, typename Allocator = std::allocator<T>>
+class sorted_unrolled_list {
+    using list_type = unrolled_list<T, NodeMaxSize, Allocator>;
+    using node = typename list_type::node;
+    using sentinel_node = typename list_type::sentinel_node;
+    using index_type = std::vector<node*, typename std::allocator_traits<Allocator>::template rebind_alloc<node*>>;
+
+public:
+    using value_type = T;
+    using key_compare = Compare;
+    using value_compare = Compare;
+    using reference = const T&;
+    using const_reference = const T&;
+    using size_type = typename list_type::size_type;
+    using difference_type = typename list_type::difference_type;
+    using allocator_type = Allocator;
+    using iterator = typename list_type::const_iterator;
+    using const_iterator = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = reverse_iterator;
+
+    sorted_unrolled_list() = default;
+    explicit sorted_unrolled_list(const Compare& comp, const Allocator& alloc = Allocator())
+        : list_(alloc), index_(alloc), comp_(comp) {}
+    template<typename InputIterator>
+    sorted_unrolled_list(InputIterator first, InputIterator last, const Compare& comp = Compare()) : comp_(comp) {
+        insert(first, last);
+    }
+    sorted_unrolled_list(std::initializer_list<T> il, const Compare& comp = Compare())
+        : sorted_unrolled_list(il.begin(), il.end(), comp) {}
+
+    sorted_unrolled_list(const sorted_unrolled_list& other) : list_(other.list_), comp_(other.comp_) { index_ = index_of(list_); }
+    /// @brief takes over the nodes (and so the index) of other, which is left empty
+    sorted_unrolled_list(sorted_unrolled_list&& other) noexcept
+        : list_(std::move(other.list_)), index_(std::move(other.index_)), comp_(other.comp_) {
+        other.index_.clear();
+    }
+    sorted_unrolled_list& operator=(const sorted_unrolled_list& other) {
+        if (this != &other) {
+            sorted_unrolled_list copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    sorted_unrolled_list& operator=(sorted_unrolled_list&& other) noexcept {
+        if (this != &other) {
+            sorted_unrolled_list moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    void swap(sorted_unrolled_list& other) noexcept {
+        list_.swap(other.list_);
+        index_.swap(other.index_);
+        std::swap(comp_, other.comp_);
+    }
+
+    iterator begin() const { return list_.begin(); }
+    iterator end() const { return list_.end(); }
+    iterator cbegin() const { return list_.cbegin(); }
+    iterator cend() const { return list_.cend(); }
+    reverse_iterator rbegin() const { return reverse_iterator(end()); }
+    reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+    const T& front() const { return list_.front(); }
+    const T& back() const { return list_.back(); }
+
+    bool empty() const { return list_.empty(); }
+    size_type size() const { return list_.size(); }
+    size_type max_size() const { return list_.max_size(); }
+    key_compare key_comp() const { return comp_; }
+    allocator_type get_allocator() const { return list_.get_allocator(); }
+
+    void clear() {
+        list_.clear();
+        index_.clear();
+    }
+
+    /// @brief first element not less than key
+    iterator lower_bound(const T& key) const { return bound<false>(key); }
+    /// @brief first element greater than key
+    iterator upper_bound(const T& key) const { return bound<true>(key); }
+    std::pair<iterator, iterator> equal_range(const T& key) const { return {lower_bound(key), upper_bound(key)}; }
+
+    iterator find(const T& key) const {
+        iterator iter = lower_bound(key);
+        return iter != end() && !comp_(key, *iter) ? iter : end();
+    }
+    bool contains(const T& key) const { return find(key) != end(); }
+    size_type count(const T& key) const {
+        auto [first, last] = equal_range(key);
+        return static_cast<size_type>(last - first);
+    }
+
+    /// @brief insert value after the elements equal to it, returns an iterator to it. Strong guarantee.
+    iterator insert(const T& value) {
+        index_.reserve(index_.size() + 1);
+        if (index_.empty()) {
+            iterator iter = list_.insert(list_.cend(), value);
+            index_.push_back(static_cast<node*>(list_type::node_of(iter)));
+            return iter;
+        }
+        auto [k, i] = locate<true>(value);
+        node* target = index_[k];
+        sentinel_node* prev = target->prev;
+        sentinel_node* next = target->next;
+        iterator iter = list_.insert(list_type::make_iterator(target, i), value);
+        if (target->prev != prev) {  // the target was full: value went into a new node in front of it
+            index_.insert(index_.begin() + k, static_cast<node*>(target->prev));
+        } else if (target->next != next) {  // the target was full and split, or value went after it
+            index_.insert(index_.begin() + k + 1, static_cast<node*>(target->next));
+        }
+        return iter;
+    }
+    template<typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+    void insert(std::initializer_list<T> il) { insert(il.begin(), il.end()); }
+
+    /// @brief insert a batch that is already sorted by Compare.
+    ///
+    /// A batch that starts at or after back() is appended in whole nodes. A batch large compared to
+    /// the list is merged with it in one pass into fresh, full nodes; a small one is inserted element
+    /// by element.
+    template<unrolled_list_compatible_range<T> R>
+    void merge(R&& sorted_batch) {
+        if constexpr (std::ranges::forward_range<R>) {
+            auto first = std::ranges::begin(sorted_batch);
+            auto last = std::ranges::end(sorted_batch);
+            if (first == last) { return; }
+            size_type batch_size = static_cast<size_type>(std::ranges::distance(first, last));
+
+            if (empty() || !comp_(*first, back())) {
+                sentinel_node* appended_after = list_.sentinel_.prev;  // the sentinel itself when empty
+                index_.reserve(index_.size() + batch_size / NodeMaxSize + 1);
+                list_.append_range(sorted_batch);
+                for (sentinel_node* curr = appended_after->next; curr != list_.sentinel(); curr = curr->next) {
+                    index_.push_back(static_cast<node*>(curr));
+                }
+            } else if (batch_size * NodeMaxSize >= size()) {
+                list_type merged(list_.get_allocator());
+                std::ranges::merge(list_, sorted_batch, std::back_inserter(merged), comp_);
+                index_type merged_index = index_of(merged);
+                list_ = std::move(merged);  // the nodes move along, merged_index stays valid
+                index_.swap(merged_index);
+            } else {
+                for (; first != last; ++first) {
+                    insert(*first);
+                }
+            }
+        } else {
+            for (auto&& value : sorted_batch) {
+                insert(value);
+            }
+        }
+    }
+
+    /// @brief returns the iterator following pos
+    iterator erase(const_iterator pos) {
+        node* target = static_cast<node*>(list_type::node_of(pos));
+        if (target->count != 1) { return list_.erase(pos); }
+        size_t k = position_of(target);
+        iterator iter = list_.erase(pos);
+        index_.erase(index_.begin() + k);
+        return iter;
+    }
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return first;
+    }
+    /// @brief erase every element equal to key, returns how many there were
+    size_type erase(const T& key) {
+        auto [first, last] = equal_range(key);
+        size_type erased = static_cast<size_type>(last - first);
+        for (size_type i = 0; i != erased; ++i) {
+            first = erase(first);
+        }
+        return erased;
+    }
+
+    bool operator==(const sorted_unrolled_list& rhs) const { return list_ == rhs.list_; }
+    auto operator<=>(const sorted_unrolled_list& rhs) const { return list_ <=> rhs.list_; }
+
+private:
+    static const T& first_of(const node* n) { return *n->data(); }
+    static const T* elements(const node* n) { return n->data(); }
+
+    static index_type index_of(const list_type& list) {
+        index_type result(list.get_allocator());
+        result.reserve(list.nodes_);
+        for (sentinel_node* curr = list.sentinel_.next; curr != list.sentinel(); curr = curr->next) {
+            result.push_back(static_cast<node*>(curr));
+        }
+        return result;
+    }
+
+    /// @brief index of the node where the first element not less than (Upper: greater than) key is,
+    /// or would be placed: the node before the first one whose minimum is already past key
+    template<bool Upper>
+    size_t node_for(const T& key) const {
+        auto past = std::partition_point(index_.begin(), index_.end(), [&](const node* n) {
+            return Upper ? !comp_(key, first_of(n)) : comp_(first_of(n), key);
+        });
+        return past == index_.begin() ? 0 : static_cast<size_t>(past - index_.begin()) - 1;
+    }
+
+    /// @brief (node index, element index) of the bound; the element index may be the node's count
+    template<bool Upper>
+    std::pair<size_t, size_t> locate(const T& key) const {
+        size_t k = node_for<Upper>(key);
+        const T* data = elements(index_[k]);
+        const T* data_end = data + index_[k]->count;
+        const T* found = Upper ? std::upper_bound(data, data_end, key, comp_) : std::lower_bound(data, data_end, key, comp_);
+        return {k, static_cast<size_t>(found - data)};
+    }
+
+    template<bool Upper>
+    iterator bound(const T& key) const {
+        if (index_.empty()) { return end(); }
+        auto [k, i] = locate<Upper>(key);
+        node* n = index_[k];
+        return i == n->count ? list_type::make_iterator(n->next, 0) : list_type::make_iterator(n, i);
+    }
+
+    /// @brief index slot of n; nodes with equal minimums are told apart by address
+    size_t position_of(const node* n) const {
+        size_t k = node_for<true>(first_of(n));
+        while (index_[k] != n) {
+            --k;
+        }
+        return k;
+    }
+
+    list_type list_;
+    index_type index_;
+    [[no_unique_address]] Compare comp_;
+};
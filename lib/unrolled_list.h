@@ -1,14 +1,77 @@
+#pragma once
+
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <compare>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
 #include <iterator>
 #include <memory>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <system_error>
+#include <thread>
 #include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "unrolled_list_kernels.h"
+
+/// Define UNROLLED_LIST_ENABLE_STATS (or configure with -DUNROLLED_LIST_ENABLE_STATS=ON) to get
+/// unrolled_list::stats(). Without it the counters are not compiled in at all.
+#ifdef UNROLLED_LIST_ENABLE_STATS
+#define UNROLLED_LIST_STAT(expr) (expr)
+#else
+#define UNROLLED_LIST_STAT(expr) ((void)0)
+#endif
+
+/// How many nodes ahead iterators (and other node walks) prefetch when they cross a node boundary.
+/// 0 disables software prefetching.
+#ifndef UNROLLED_LIST_PREFETCH_DISTANCE
+#define UNROLLED_LIST_PREFETCH_DISTANCE 1
+#endif
+
+/// Threads the parallel constructor (unrolled_list(parallel_build, first, last)) may use;
+/// 0 means std::thread::hardware_concurrency().
+#ifndef UNROLLED_LIST_PARALLEL_THREADS
+#define UNROLLED_LIST_PARALLEL_THREADS 0
+#endif
+
+/// Tag for the from-range constructor. Standard libraries without the C++23 ranges-aware container
+/// constructors (__cpp_lib_containers_ranges) do not declare std::from_range, so provide our own.
+#ifdef __cpp_lib_containers_ranges
+using from_range_t = std::from_range_t;
+inline constexpr from_range_t from_range = std::from_range;
+#else
+struct from_range_t { explicit from_range_t() = default; };
+inline constexpr from_range_t from_range{};
+#endif
 
-template<typename T, size_t NodeMaxSize = 10, typename Allocator = std::allocator<T>>
+/// Tag for the parallel constructor. Not std::execution::par: <execution> pulls in the parallel
+/// STL backend (TBB with libstdc++), which every user of this header would then have to link.
+struct parallel_build_t { explicit parallel_build_t() = default; };
+inline constexpr parallel_build_t parallel_build{};
+
+template<typename R, typename T>
+concept unrolled_list_compatible_range = std::ranges::input_range<R> && std::convertible_to<std::ranges::range_reference_t<R>, T>;
+
+template<typename T, typename Compare, size_t NodeMaxSize, typename Allocator>
+class sorted_unrolled_list;
+
+/// Snapshots enables snapshot(): nodes then carry a reference count and every write to a node
+/// first checks whether a snapshot shares it. Without it neither is compiled in.
+template<typename T, size_t NodeMaxSize = 10, typename Allocator = std::allocator<T>, bool Snapshots = false>
 class unrolled_list {
     static_assert(NodeMaxSize > 0, "NodeMaxSize must be greater than zero");
 
+    template<typename, typename, size_t, typename>
+    friend class sorted_unrolled_list;
+
     template<bool B, typename U, typename F>
     struct conditional { using type = U; };
 
@@ -24,25 +87,121 @@ public:
     using difference_type = std::ptrdiff_t;
     using size_type = size_t;
     using allocator_type = Allocator;
+    /// result of operator<=>: T's own three-way result, std::weak_ordering when T only has operator<
+    using ordering_type = typename conditional<std::three_way_comparable<T>,
+        std::compare_three_way_result<T>, std::type_identity<std::weak_ordering>>::type::type;
 
 private:
+    /// narrowest unsigned type that holds NodeMaxSize
+    using count_type = typename conditional<NodeMaxSize <= UINT8_MAX, uint8_t,
+        typename conditional<NodeMaxSize <= UINT16_MAX, uint16_t,
+        typename conditional<NodeMaxSize <= UINT32_MAX, uint32_t, uint64_t>::type>::type>::type;
+
+    /// stands in for the reference count of lists without snapshots and takes no room
+    struct no_refs { explicit no_refs(uint32_t) {} };
+
+    /// @brief the node header: the links and the element count share the first cache line of a node.
+    /// The sentinel is a bare header: the list recognises it by address, iterators (which do not know
+    /// the list) by its count, since every node linked into the list holds at least one element. A
+    /// node's capacity is NodeMaxSize unless it was allocated in adaptive mode (see
+    /// set_adaptive_capacity()); then its storage only has room for `capacity` elements. All fields
+    /// are in this one standard-layout struct, so the elements can start right after the last one.
     struct sentinel_node {
-        sentinel_node(bool is_s = true) : is_sentinel(is_s) {}
         sentinel_node* next;
         sentinel_node* prev;
-        const bool is_sentinel = true;
+        count_type count = 0;
+        count_type capacity = NodeMaxSize;
+        /// the list plus every snapshot that shares the node
+        [[no_unique_address]] typename conditional<Snapshots, std::atomic<uint32_t>, no_refs>::type refs{1};
     };
+    /// @brief a header constructed at the start of the node's storage; the elements follow it at
+    /// data_offset. The storage is never an object of its own, so it may be shorter than a full node.
     struct node : sentinel_node {
-        using sentinel_node::next;
-        using sentinel_node::prev;
-        node() : sentinel_node(false) {}
-        alignas(T) unsigned char data[sizeof(T) * NodeMaxSize];
-        size_t count = 0;
+        unsigned char* bytes() noexcept { return reinterpret_cast<unsigned char*>(this) + data_offset; }
+        T* data() noexcept { return reinterpret_cast<T*>(bytes()); }
+        const T* data() const noexcept { return reinterpret_cast<const T*>(reinterpret_cast<const unsigned char*>(this) + data_offset); }
+    };
+
+    /// end of the header's last field: the reference count, or the capacity without snapshots
+    static constexpr size_t header_size = Snapshots ? offsetof(sentinel_node, refs) + sizeof(uint32_t)
+                                                    : offsetof(sentinel_node, capacity) + sizeof(count_type);
+    /// offset of the first element from the start of a node: the end of the header rounded up to T
+    static constexpr size_t data_offset = (header_size + alignof(T) - 1) / alignof(T) * alignof(T);
+    /// storage of a node of full capacity
+    struct alignas(std::max(alignof(sentinel_node), alignof(T))) node_storage {
+        unsigned char bytes[data_offset + sizeof(T) * NodeMaxSize];
     };
 
-    sentinel_node* begin_;
-    sentinel_node* end_;
+    static bool is_sentinel(const sentinel_node* n) noexcept { return n->count == 0; }
+
+    /// @brief touch the headers of the nodes that follow `from` (in the `next` or `prev` direction) so that the walk
+    /// does not stall on a cache miss every NodeMaxSize elements. Nodes closer than the distance were
+    /// already requested by earlier calls, so chasing their links is cheap.
+    template <bool Forward>
+    static void prefetch_nodes([[maybe_unused]] const sentinel_node* from) noexcept {
+#if UNROLLED_LIST_PREFETCH_DISTANCE > 0 && defined(__GNUC__)
+        for (size_t i = 0; i != UNROLLED_LIST_PREFETCH_DISTANCE && !is_sentinel(from); ++i) {
+            from = Forward ? from->next : from->prev;
+            __builtin_prefetch(from);
+        }
+#endif
+    }
+
+    /// the list is a ring through the sentinel stored right here: sentinel_.next is the first node,
+    /// sentinel_.prev the last one, and an empty list points to itself, so it owns no heap memory
+    sentinel_node sentinel_;
     size_type size_ = 0;
+    size_type nodes_ = 0;
+    /// slots the linked nodes of reduced capacity lack compared to full ones, for capacity()
+    size_type short_slots_ = 0;
+    /// set by snapshot(); while it is false no node of the list is shared and copy-on-write is skipped.
+    /// Always false without Snapshots.
+    bool may_share_ = false;
+    /// see set_adaptive_capacity()
+    bool adaptive_ = false;
+    /// empty nodes set aside by reserve(), chained through `next`
+    sentinel_node* spare_ = nullptr;
+    size_type spare_nodes_ = 0;
+    /// freed nodes go back to the spare chain while it holds fewer than this many
+    size_type reserved_nodes_ = 0;
+
+#ifdef UNROLLED_LIST_ENABLE_STATS
+public:
+    struct statistics {
+        /// bucket i counts nodes filled to [10*i%, 10*(i+1)%), the last bucket counts full nodes
+        static constexpr size_type histogram_buckets = 11;
+
+        size_type nodes = 0;
+        size_type fill_histogram[histogram_buckets] = {};
+        size_type bytes_used = 0;
+        size_type payload_bytes = 0;
+
+        size_type splits = 0;
+        size_type node_allocations = 0;
+        size_type node_frees = 0;
+        size_type bytes_allocated = 0;
+        size_type element_moves = 0;
+    };
+
+private:
+    struct operation_counters {
+        size_type splits = 0;
+        size_type node_allocations = 0;
+        size_type node_frees = 0;
+        size_type bytes_allocated = 0;
+        size_type element_moves = 0;
+
+        operation_counters& operator+=(const operation_counters& rhs) {
+            splits += rhs.splits;
+            node_allocations += rhs.node_allocations;
+            node_frees += rhs.node_frees;
+            bytes_allocated += rhs.bytes_allocated;
+            element_moves += rhs.element_moves;
+            return *this;
+        }
+    };
+    operation_counters counters_;
+#endif
 
     template <bool isConst>
     struct list_iterator {
@@ -61,19 +220,20 @@ private:
 
     public:
         typename conditional<isConst, const_reference, reference>::type operator*() const {
-            if (node->is_sentinel) { throw std::invalid_argument("cannot dereference a no-value iterator"); }
-            return reinterpret_cast<T*>(static_cast<struct node*>(node)->data)[index];
+            if (is_sentinel(node)) { throw std::invalid_argument("cannot dereference a no-value iterator"); }
+            return static_cast<struct node*>(node)->data()[index];
         }
         typename conditional<isConst, const_pointer, pointer>::type operator->() const {
-            if (node->is_sentinel) { throw std::invalid_argument("cannot dereference a no-value iterator"); }
-            return reinterpret_cast<T*>(static_cast<struct node*>(node)->data) + index;
+            if (is_sentinel(node)) { throw std::invalid_argument("cannot dereference a no-value iterator"); }
+            return static_cast<struct node*>(node)->data() + index;
         }
 
         list_iterator& operator++() {
-            if (node->is_sentinel) { throw std::out_of_range("cannot increment the end (rend) iterator"); }
+            if (is_sentinel(node)) { throw std::out_of_range("cannot increment the end (rend) iterator"); }
             if (++index >= static_cast<struct node*>(node)->count) {
                 index = 0;
                 node = node->next;
+                prefetch_nodes<true>(node);
             }
             return *this;
         }
@@ -84,9 +244,14 @@ private:
         }
 
         list_iterator& operator--() {
-            if (node->prev->is_sentinel && index == 0) { throw std::out_of_range("cannot decrement the begin (rbegin) iterator"); }
+            if (is_sentinel(node) && index == empty_begin_index) { throw std::out_of_range("cannot decrement the begin (rbegin) iterator"); }
+            if (is_sentinel(node->prev) && index == 0) {
+                if (is_sentinel(node)) { return *this; }  // end() of an empty list is also its begin()
+                throw std::out_of_range("cannot decrement the begin (rbegin) iterator");
+            }
             if (index == 0) {
                 node = node->prev;
+                prefetch_nodes<false>(node);
                 index = static_cast<struct node*>(node)->count - 1;
             } else { --index; }
             return *this;
@@ -97,34 +262,134 @@ private:
             return iter;
         }
 
+        /// @brief jump k elements ahead (behind for negative k), skipping whole nodes: O(k / NodeMaxSize)
+        list_iterator& operator+=(difference_type k) {
+            if (k < 0) { return *this -= -k; }
+            size_type left = static_cast<size_type>(k);
+            while (left != 0 && index + left >= node->count) {
+                if (is_sentinel(node)) { throw std::out_of_range("cannot advance past the end iterator"); }
+                left -= node->count - index;
+                node = node->next;
+                index = 0;
+            }
+            if (left != 0) {
+                index += left;
+            }
+            return *this;
+        }
+        list_iterator& operator-=(difference_type k) {
+            if (k < 0) { return *this += -k; }
+            size_type left = static_cast<size_type>(k);
+            if (left != 0 && is_sentinel(node)) { index = 0; }
+            while (left > index) {
+                if (is_sentinel(node->prev)) { throw std::out_of_range("cannot move before the begin iterator"); }
+                left -= index + 1;
+                node = node->prev;
+                index = node->count - 1;
+            }
+            index -= left;
+            return *this;
+        }
+        friend list_iterator operator+(list_iterator iter, difference_type k) { return iter += k; }
+        friend list_iterator operator+(difference_type k, list_iterator iter) { return iter += k; }
+        friend list_iterator operator-(list_iterator iter, difference_type k) { return iter -= k; }
+
+        /// @brief signed number of elements from rhs to lhs; walks the nodes forward from rhs and,
+        /// when the end is reached first, from lhs
+        friend difference_type operator-(const list_iterator& lhs, const list_iterator& rhs) {
+            difference_type result = 0;
+            if (rhs.distance_to(lhs, result)) { return result; }
+            lhs.distance_to(rhs, result);
+            return -result;
+        }
+
+        /// found by argument-dependent lookup, so `using std::advance; advance(it, k);` takes the
+        /// node-skipping path (a qualified std::advance still steps one element at a time)
+        template<typename Distance>
+        friend void advance(list_iterator& iter, Distance k) { iter += static_cast<difference_type>(k); }
+        friend difference_type distance(const list_iterator& first, const list_iterator& last) { return last - first; }
+
         bool operator==(const list_iterator& rhs) const noexcept {
-            if ((node->prev->is_sentinel && node->next->is_sentinel && static_cast<struct node*>(node)->count == 0) ||  // check for empty container
-                (rhs.node->prev->is_sentinel && rhs.node->next->is_sentinel && static_cast<struct node*>(rhs.node)->count == 0)) { return true; }
-            if (node->is_sentinel && rhs.node->is_sentinel) { return true; }
-            if (node != rhs.node) { return false; }
-            return index == rhs.index && static_cast<struct node*>(node)->data[index] == static_cast<struct node*>(rhs.node)->data[rhs.index];
+            return node == rhs.node && (index == rhs.index || is_sentinel(node));
         }
         bool operator!=(const list_iterator& rhs) const noexcept {
             return !(*this == rhs);
         }
 
     private:
+        /// @brief the forward distance to target, false if the walk hits the end before reaching it
+        bool distance_to(const list_iterator& target, difference_type& result) const {
+            difference_type walked = is_sentinel(node) ? 0 : -static_cast<difference_type>(index);
+            for (const sentinel_node* curr = node; curr != target.node; curr = curr->next) {
+                if (is_sentinel(curr)) { return false; }
+                walked += curr->count;
+            }
+            result = walked + (is_sentinel(target.node) ? 0 : static_cast<difference_type>(target.index));
+            return true;
+        }
+
         sentinel_node* node;
         size_t index;
     };
 
-    using sentinel_node_allocator_type = std::allocator<sentinel_node>;
-    using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node>;
-    sentinel_node_allocator_type sentinel_node_allocator;
+    /// @brief the list seen node by node: each element is a span over one node's elements
+    template <bool isConst>
+    class list_node_view : public std::ranges::view_interface<list_node_view<isConst>> {
+        using span_type = std::span<typename conditional<isConst, const T, T>::type>;
+
+    public:
+        class iterator {
+        public:
+            using value_type = span_type;
+            using difference_type = unrolled_list::difference_type;
+            using iterator_concept = std::bidirectional_iterator_tag;
+
+            iterator() = default;
+            explicit iterator(sentinel_node* n) : node(n) {}
+
+            span_type operator*() const {
+                auto* casted = static_cast<struct node*>(node);
+                return span_type(casted->data(), casted->count);
+            }
+            iterator& operator++() { node = node->next; return *this; }
+            iterator operator++(int) { iterator copy = *this; ++*this; return copy; }
+            iterator& operator--() { node = node->prev; return *this; }
+            iterator operator--(int) { iterator copy = *this; --*this; return copy; }
+            bool operator==(const iterator& rhs) const { return node == rhs.node; }
+
+        private:
+            sentinel_node* node = nullptr;
+        };
+
+        list_node_view() = default;
+        list_node_view(sentinel_node* first, sentinel_node* last) : first_(first), last_(last) {}
+
+        iterator begin() const { return iterator(first_); }
+        iterator end() const { return iterator(last_); }
+
+    private:
+        sentinel_node* first_ = nullptr;
+        sentinel_node* last_ = nullptr;
+    };
+
+    using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_storage>;
     node_allocator_type node_allocator;
+
+    /// nodes of reduced capacity are allocated as a run of these instead of as one node_storage
+    struct alignas(node_storage) node_unit { unsigned char bytes[alignof(node_storage)]; };
+    using unit_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_unit>;
     allocator_type allocator;
 
-    void initialize_copy(const unrolled_list& ul) {
-        for (auto iter = ul.begin(); iter != ul.end(); ++iter) { push_back(*iter); }
-    }
+    sentinel_node* sentinel() const { return const_cast<sentinel_node*>(&sentinel_); }
+
+    /// begin() of an empty list is the sentinel, like end(), tagged with this index so that
+    /// decrementing it is still reported as decrementing begin()
+    static constexpr size_t empty_begin_index = 1;
+
+    void initialize_copy(const unrolled_list& ul) { append_range(ul); }
     template<typename ForwardIterator>
     void initialize_copy(ForwardIterator begin, ForwardIterator end) {
-        while (begin != end) { push_back(*begin++); }
+        append_range(std::ranges::subrange(begin, end));
     }
 
 public:
@@ -133,52 +398,296 @@ public:
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-    /// @brief we allocate to node:  <node [begin]> -- <sentinel_node [end]>
-    /// and we will be always work between begin and end:  <node [begin]> -- {inserting} -- <sentinel_node [end]>
-    unrolled_list() {
-        begin_ = std::allocator_traits<node_allocator_type>::allocate(node_allocator, 1);
-        std::allocator_traits<node_allocator_type>::construct(node_allocator, static_cast<node*>(begin_));
-        end_ = std::allocator_traits<sentinel_node_allocator_type>::allocate(sentinel_node_allocator, 1);
-        std::allocator_traits<sentinel_node_allocator_type>::construct(sentinel_node_allocator, end_);
-        begin_->prev = begin_->next = end_->next = end_;
-        end_->prev = begin_;
-    }
+    /// @brief owns one node taken out of a list by extract_front_node() / extract_node(), elements
+    /// included, until insert_node() links it into a list again. Destroying a non-empty handle
+    /// destroys the elements and frees the node. Move-only.
+    class node_type {
+    public:
+        using value_type = T;
+
+        node_type() = default;
+        node_type(node_type&& other) noexcept
+            : node_(std::exchange(other.node_, nullptr)), node_allocator_(other.node_allocator_) {}
+        node_type& operator=(node_type&& other) noexcept {
+            if (this != &other) {
+                reset();
+                node_ = std::exchange(other.node_, nullptr);
+                node_allocator_ = other.node_allocator_;
+            }
+            return *this;
+        }
+        ~node_type() { reset(); }
+
+        bool empty() const noexcept { return node_ == nullptr; }
+        explicit operator bool() const noexcept { return node_ != nullptr; }
+        size_type size() const noexcept { return node_ == nullptr ? 0 : node_->count; }
+        /// @brief the elements of the node, in list order
+        std::span<T> elements() const noexcept {
+            if (node_ == nullptr) { return {}; }
+            return {node_->data(), node_->count};
+        }
+
+    private:
+        friend unrolled_list;
+        node_type(node* n, const node_allocator_type& alloc) : node_(n), node_allocator_(alloc) {}
+
+        void reset() noexcept {
+            if (node_ == nullptr) { return; }
+            std::destroy_n(node_->data(), node_->count);
+            release_node(node_allocator_, node_);
+            node_ = nullptr;
+        }
+
+        node* node_ = nullptr;
+        node_allocator_type node_allocator_;
+    };
+
+    /// @brief read-only picture of the list at the moment snapshot() was called.
+    ///
+    /// It shares the list's nodes (reference-counted in the node header) instead of copying the
+    /// elements, and keeps its own array of node pointers, so it never follows the links the list
+    /// keeps rewriting. Before modifying a node the list replaces a shared one with a private copy,
+    /// so the snapshot does not see later changes. A snapshot may be read, copied and destroyed on
+    /// another thread while the list is modified; it may outlive the list.
+    class snapshot_type {
+        using spine_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node*>;
+
+    public:
+        class const_iterator {
+        public:
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = const T&;
+            using pointer = const T*;
+            using iterator_category = std::bidirectional_iterator_tag;
+
+            const_iterator() = default;
+
+            reference operator*() const { return (*spine_)->data()[index_]; }
+            pointer operator->() const { return (*spine_)->data() + index_; }
+
+            const_iterator& operator++() {
+                if (++index_ == (*spine_)->count) {
+                    ++spine_;
+                    index_ = 0;
+                }
+                return *this;
+            }
+            const_iterator operator++(int) {
+                const_iterator iter = *this;
+                ++(*this);
+                return iter;
+            }
+            const_iterator& operator--() {
+                if (index_ == 0) {
+                    --spine_;
+                    index_ = (*spine_)->count;
+                }
+                --index_;
+                return *this;
+            }
+            const_iterator operator--(int) {
+                const_iterator iter = *this;
+                --(*this);
+                return iter;
+            }
+
+            bool operator==(const const_iterator& rhs) const noexcept { return spine_ == rhs.spine_ && index_ == rhs.index_; }
+            bool operator!=(const const_iterator& rhs) const noexcept { return !(*this == rhs); }
+
+        private:
+            friend snapshot_type;
+            const_iterator(node* const* spine, size_t index) : spine_(spine), index_(index) {}
+
+            node* const* spine_ = nullptr;
+            size_t index_ = 0;
+        };
+        using value_type = T;
+        using size_type = unrolled_list::size_type;
+        using difference_type = unrolled_list::difference_type;
+        using reference = const T&;
+        using const_reference = const T&;
+        using iterator = const_iterator;
+
+        // constrained like snapshot(): without Snapshots the nodes have no reference count to manage
+        snapshot_type() requires Snapshots = default;
+        snapshot_type(const snapshot_type& other) requires Snapshots : snapshot_type(other.node_allocator_, other.nodes_, other.size_) {
+            for (size_type i = 0; i != nodes_; ++i) {
+                other.spine_[i]->refs.fetch_add(1, std::memory_order_relaxed);
+                spine_[i] = other.spine_[i];
+            }
+        }
+        snapshot_type(snapshot_type&& other) noexcept requires Snapshots
+            : spine_(std::exchange(other.spine_, nullptr)), nodes_(std::exchange(other.nodes_, 0)), size_(std::exchange(other.size_, 0)),
+              node_allocator_(other.node_allocator_), spine_allocator_(other.spine_allocator_) {}
+        snapshot_type& operator=(snapshot_type other) noexcept requires Snapshots {
+            std::swap(spine_, other.spine_);
+            std::swap(nodes_, other.nodes_);
+            std::swap(size_, other.size_);
+            std::swap(node_allocator_, other.node_allocator_);
+            std::swap(spine_allocator_, other.spine_allocator_);
+            return *this;
+        }
+        /// @brief releases the shared nodes; the last owner of a node destroys it
+        ~snapshot_type() requires Snapshots {
+            for (size_type i = 0; i != nodes_; ++i) {
+                node* n = spine_[i];
+                if (n->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) { continue; }
+                std::destroy_n(n->data(), n->count);
+                release_node(node_allocator_, n);
+            }
+            if (spine_ != nullptr) { std::allocator_traits<spine_allocator_type>::deallocate(spine_allocator_, spine_, nodes_); }
+        }
+
+        size_type size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        const_iterator begin() const { return {spine_, 0}; }
+        const_iterator end() const { return {spine_ + nodes_, 0}; }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        const_reference front() const { return *begin(); }
+        const_reference back() const { return *(--end()); }
+
+    private:
+        friend unrolled_list;
+        snapshot_type(const node_allocator_type& alloc, size_type nodes, size_type size)
+            : nodes_(nodes), size_(size), node_allocator_(alloc), spine_allocator_(alloc) {
+            if (nodes_ != 0) { spine_ = std::allocator_traits<spine_allocator_type>::allocate(spine_allocator_, nodes_); }
+        }
+
+        node** spine_ = nullptr;
+        size_type nodes_ = 0;
+        size_type size_ = 0;
+        node_allocator_type node_allocator_;
+        spine_allocator_type spine_allocator_;
+    };
+
+    /// @brief nothing is allocated until the first element arrives:  <sentinel> -- {nodes} -- <sentinel>
+    unrolled_list() : unrolled_list(allocator_type()) {}
     unrolled_list(const unrolled_list& ul) : unrolled_list() { initialize_copy(ul); }
-    unrolled_list(const unrolled_list& ul, const allocator_type& alloc) : unrolled_list(ul) { allocator = alloc; }
-    unrolled_list(const allocator_type& alloc) : unrolled_list() { allocator = alloc; }
+    /// @brief takes over the nodes of ul, no allocation; ul is left empty
+    unrolled_list(unrolled_list&& ul) noexcept
+        : size_(ul.size_), nodes_(ul.nodes_), short_slots_(ul.short_slots_), may_share_(ul.may_share_), adaptive_(ul.adaptive_),
+          spare_(ul.spare_), spare_nodes_(ul.spare_nodes_), reserved_nodes_(ul.reserved_nodes_),
+          node_allocator(ul.node_allocator), allocator(ul.allocator) {
+        sentinel_.next = ul.sentinel_.next;
+        sentinel_.prev = ul.sentinel_.prev;
+        adopt_ring(ul.sentinel_);
+        ul.sentinel_.next = ul.sentinel_.prev = ul.sentinel();
+        ul.size_ = ul.nodes_ = ul.short_slots_ = ul.spare_nodes_ = ul.reserved_nodes_ = 0;
+        ul.may_share_ = false;
+        ul.spare_ = nullptr;
+    }
+    unrolled_list(const unrolled_list& ul, const allocator_type& alloc) : unrolled_list(alloc) { initialize_copy(ul); }
+    /// @brief the nodes are allocated with alloc rebound to the node type
+    unrolled_list(const allocator_type& alloc) : node_allocator(alloc), allocator(alloc) { sentinel_.next = sentinel_.prev = sentinel(); }
     unrolled_list(size_type n, value_type el) : unrolled_list() {
         for (size_type i = 0; i != n; ++i) { push_back(el); }
     }
     template<typename ForwardIterator>
     unrolled_list(ForwardIterator begin, ForwardIterator end) : unrolled_list() { initialize_copy(begin, end); }
     template<typename ForwardIterator>
-    unrolled_list(ForwardIterator begin, ForwardIterator end, Allocator& alloc) : unrolled_list(begin, end) { allocator = alloc; }
+    unrolled_list(ForwardIterator begin, ForwardIterator end, const Allocator& alloc) : unrolled_list(alloc) { initialize_copy(begin, end); }
     unrolled_list(std::initializer_list<T> il) : unrolled_list() { initialize_copy(il.begin(), il.end()); }
+    unrolled_list(std::initializer_list<T> il, const allocator_type& alloc) : unrolled_list(alloc) { initialize_copy(il.begin(), il.end()); }
+    template<unrolled_list_compatible_range<T> R>
+    unrolled_list(from_range_t, R&& rg) : unrolled_list() { append_range(std::forward<R>(rg)); }
+    template<unrolled_list_compatible_range<T> R>
+    unrolled_list(from_range_t, R&& rg, const allocator_type& alloc) : unrolled_list(alloc) { append_range(std::forward<R>(rg)); }
+
+    /// @brief build on several threads: the input is cut into chunks of whole nodes, one thread
+    /// builds each chunk into a list of its own and the lists are spliced together, so the nodes come
+    /// out exactly as from the serial constructor. An exception thrown while building any chunk is
+    /// rethrown once every thread has finished.
+    ///
+    /// Builds serially for inputs under parallel_min_chunk elements per thread, and for allocators
+    /// that are not always equal: their instances may share state that is not thread-safe, as
+    /// slab_allocator's pool is.
+    template<std::random_access_iterator Iterator>
+    unrolled_list(parallel_build_t, Iterator first, Iterator last) : unrolled_list() {
+        size_type n = static_cast<size_type>(last - first);
+        size_type chunks = 1;
+        if constexpr (std::allocator_traits<Allocator>::is_always_equal::value) {
+            size_type threads = UNROLLED_LIST_PARALLEL_THREADS != 0 ? UNROLLED_LIST_PARALLEL_THREADS : std::thread::hardware_concurrency();
+            chunks = std::min(threads, n / parallel_min_chunk);
+        }
+        if (chunks < 2) {
+            append_range(std::ranges::subrange(first, last));
+            return;
+        }
+
+        size_type per_chunk = (n + chunks - 1) / chunks;
+        size_type chunk_size = (per_chunk + NodeMaxSize - 1) / NodeMaxSize * NodeMaxSize;  // ends on a node boundary
+        std::vector<unrolled_list> parts(chunks);
+        std::vector<std::exception_ptr> errors(chunks);
+        auto build = [&](size_type k) {
+            try {
+                size_type from = std::min(n, k * chunk_size);
+                size_type to = std::min(n, from + chunk_size);
+                parts[k].append_range(std::ranges::subrange(first + from, first + to));
+            } catch (...) {
+                errors[k] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+        for (size_type k = 1; k != chunks; ++k) {
+            try {
+                workers.emplace_back(build, k);
+            } catch (const std::system_error&) {
+                build(k);  // no thread to spare, build it here
+            }
+        }
+        build(0);
+        for (std::thread& worker : workers) { worker.join(); }
+        for (const std::exception_ptr& error : errors) {
+            if (error) { std::rethrow_exception(error); }
+        }
+        for (unrolled_list& part : parts) {
+            UNROLLED_LIST_STAT(counters_ += part.counters_);
+            splice(cend(), std::move(part));
+        }
+    }
     unrolled_list& operator=(const unrolled_list& rhs) {
         if (this == &rhs) { return *this; }
         clear();
         initialize_copy(rhs);
         return *this;
     }
+    unrolled_list& operator=(unrolled_list&& rhs) noexcept {
+        if (this == &rhs) { return *this; }
+        clear();
+        shrink_to_fit();
+        swap(rhs);
+        return *this;
+    }
     unrolled_list& operator=(std::initializer_list<T> il) {
         clear();
         initialize_copy(il.begin(), il.end());
+        return *this;
     }
 
     ~unrolled_list() {
         clear();
-        std::allocator_traits<node_allocator_type>::destroy(node_allocator, static_cast<node*>(begin_));
-        std::allocator_traits<node_allocator_type>::deallocate(node_allocator, static_cast<node*>(begin_), 1);
-        std::allocator_traits<sentinel_node_allocator_type>::destroy(sentinel_node_allocator, end_);
-        std::allocator_traits<sentinel_node_allocator_type>::deallocate(sentinel_node_allocator, end_, 1);
+        shrink_to_fit();
     }
 
-    iterator begin() { return {begin_, 0}; }
-    const_iterator begin() const { return {begin_, 0}; }
-    const_iterator cbegin() const { return {begin_, 0}; }
-    iterator end() { return {end_, 0}; }
-    const_iterator end() const { return {end_, 0}; }
-    const_iterator cend() const { return {end_, 0}; }
+    /// non-const begin()/end()/nodes() hand out write access to any element, so they first unshare
+    /// every node still shared with a snapshot (nothing to do if snapshot() was never called)
+    iterator begin() {
+        unshare_all();
+        return {sentinel_.next, size_ == 0 ? empty_begin_index : 0};
+    }
+    const_iterator begin() const { return {sentinel_.next, size_ == 0 ? empty_begin_index : 0}; }
+    const_iterator cbegin() const { return begin(); }
+    iterator end() {
+        unshare_all();
+        return {sentinel(), 0};
+    }
+    const_iterator end() const { return {sentinel(), 0}; }
+    const_iterator cend() const { return {sentinel(), 0}; }
 
     reverse_iterator rbegin() { return reverse_iterator(end()); }
     const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
@@ -187,28 +696,118 @@ public:
     const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
     const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
 
+    /// @brief bytes a node spends on anything but its elements (links, count, padding)
+    static constexpr size_type node_overhead = sizeof(node_storage) - sizeof(T) * NodeMaxSize;
+
+    using node_view = list_node_view<false>;
+    using const_node_view = list_node_view<true>;
 
+    /// @brief chunk-wise view for ranges pipelines: one std::span per node, in list order
+    node_view nodes() {
+        unshare_all();
+        return {sentinel_.next, sentinel()};
+    }
+    const_node_view nodes() const { return {sentinel_.next, sentinel()}; }
+
+    /// @brief first element equal to value, end() if there is none. The search runs node by node
+    /// over the contiguous blocks, vectorized for arithmetic T (see unrolled_list_kernels.h).
+    const_iterator find(const T& value) const {
+        for (sentinel_node* curr = sentinel_.next; curr != sentinel(); curr = curr->next) {
+            prefetch_nodes<true>(curr);
+            size_t index = kernels::find(elements_of(curr), curr->count, value);
+            if (index != curr->count) { return {curr, index}; }
+        }
+        return end();
+    }
+    iterator find(const T& value) { return writable(std::as_const(*this).find(value)); }
+
+    size_type count(const T& value) const {
+        size_type result = 0;
+        for (sentinel_node* curr = sentinel_.next; curr != sentinel(); curr = curr->next) {
+            prefetch_nodes<true>(curr);
+            result += kernels::count(elements_of(curr), curr->count, value);
+        }
+        return result;
+    }
+    bool contains(const T& value) const { return find(value) != end(); }
+
+    /// @brief first smallest element by operator<, end() for an empty list
+    const_iterator min_element() const { return extreme<false>(); }
+    iterator min_element() { return writable(extreme<false>()); }
+    /// @brief first largest element by operator<, end() for an empty list
+    const_iterator max_element() const { return extreme<true>(); }
+    iterator max_element() { return writable(extreme<true>()); }
+
+
+    /// @brief compares the two node chains block by block: memcmp for integral, enum and pointer
+    /// element types, operator== otherwise
     bool operator==(const unrolled_list& rhs) const {
         if (size_ != rhs.size_) { return false; }
-        unrolled_list::const_iterator curr_lhs = cbegin();
-        unrolled_list::const_iterator curr_rhs = rhs.cbegin();
-        while (curr_lhs != cend()) {
-            if (*curr_lhs++ != *curr_rhs++) { return false; }
-        }
-        return true;
+        bool equal = true;
+        zip_blocks(rhs, [&equal](const T* lhs_block, const T* rhs_block, size_type n) {
+            if constexpr (bytewise_comparable) {
+                equal = std::memcmp(lhs_block, rhs_block, n * sizeof(T)) == 0;
+            } else {
+                equal = std::equal(lhs_block, lhs_block + n, rhs_block);
+            }
+            return !equal;
+        });
+        return equal;
     }
     bool operator!=(const unrolled_list& rhs) const { return !(*this == rhs); }
 
-    void swap(unrolled_list& rhs) {
-        sentinel_node* t_begin = begin_;
-        sentinel_node* t_end = end_;
-        size_t t_size = size_;
-        begin_ = rhs.begin_;
-        end_ = rhs.end_;
-        size_ = rhs.size_;
-        rhs.begin_ = t_begin;
-        rhs.end_ = t_end;
-        rhs.size_ = t_size;
+    /// @brief lexicographic, like std::lexicographical_compare_three_way, walking the node chains block
+    /// by block; for integral, enum and pointer T blocks that memcmp equal are skipped without comparing
+    /// elements. Uses T's <=> or, lacking it, operator< (then the result is a std::weak_ordering).
+    ordering_type operator<=>(const unrolled_list& rhs) const
+        requires std::three_way_comparable<T> || requires(const T& a) { { a < a } -> std::convertible_to<bool>; }
+    {
+        ordering_type result = ordering_type::equivalent;
+        zip_blocks(rhs, [&result](const T* lhs_block, const T* rhs_block, size_type n) {
+            if constexpr (bytewise_comparable) {
+                if (std::memcmp(lhs_block, rhs_block, n * sizeof(T)) == 0) { return false; }
+            }
+            for (size_type i = 0; i != n; ++i) {
+                result = synth_three_way(lhs_block[i], rhs_block[i]);
+                if (result != 0) { return true; }
+            }
+            return false;
+        });
+        if (result != 0) { return result; }
+        return size_ <=> rhs.size_;
+    }
+
+    /// @brief share the current contents with a read-only snapshot_type: O(nodes), no element is
+    /// copied. Afterwards the first change to a node copies that node only; non-const begin(),
+    /// end() and nodes() unshare every node. Iterators, cursors and node views obtained before
+    /// the snapshot must not be used to write through. Only for lists with Snapshots.
+    snapshot_type snapshot() requires Snapshots {
+        snapshot_type result(node_allocator, nodes_, size_);
+        size_type i = 0;
+        for (sentinel_node* curr = sentinel_.next; curr != sentinel(); curr = curr->next) {
+            static_cast<node*>(curr)->refs.fetch_add(1, std::memory_order_relaxed);
+            result.spine_[i++] = static_cast<node*>(curr);
+        }
+        may_share_ = may_share_ || nodes_ != 0;
+        return result;
+    }
+
+    void swap(unrolled_list& rhs) noexcept {
+        std::swap(sentinel_.next, rhs.sentinel_.next);
+        std::swap(sentinel_.prev, rhs.sentinel_.prev);
+        adopt_ring(rhs.sentinel_);
+        rhs.adopt_ring(sentinel_);
+        std::swap(size_, rhs.size_);
+        std::swap(nodes_, rhs.nodes_);
+        std::swap(short_slots_, rhs.short_slots_);
+        std::swap(may_share_, rhs.may_share_);
+        std::swap(adaptive_, rhs.adaptive_);
+        std::swap(spare_, rhs.spare_);
+        std::swap(spare_nodes_, rhs.spare_nodes_);
+        std::swap(reserved_nodes_, rhs.reserved_nodes_);
+        std::swap(node_allocator, rhs.node_allocator);
+        std::swap(allocator, rhs.allocator);
+        UNROLLED_LIST_STAT(std::swap(counters_, rhs.counters_));
     }
     inline static void swap(unrolled_list& lhs, unrolled_list& rhs) { lhs.swap(rhs); }
 
@@ -219,81 +818,628 @@ public:
 
     bool empty() const { return size_ == 0; }
 
+    /// @brief number of elements the already allocated nodes (spare ones included) can hold
+    size_type capacity() const { return (nodes_ + spare_nodes_) * NodeMaxSize - short_slots_; }
+
+    /// the parallel constructor gives each thread at least this many elements
+    static constexpr size_type parallel_min_chunk = size_type{1} << 14;
+
+    /// smallest node capacity picked in adaptive mode
+    static constexpr size_type min_adaptive_capacity = std::min<size_type>(4, NodeMaxSize);
+
+    /// @brief turn adaptive node capacity on or off (off by default). In adaptive mode a node
+    /// allocated while the list holds n elements gets room for about n / 8 of them, rounded up to a
+    /// power of two and kept within [min_adaptive_capacity, NodeMaxSize]: a short list takes a few
+    /// small nodes instead of mostly empty full ones, and as it grows its new nodes double in size
+    /// up to the full NodeMaxSize runs that scans want. Nodes keep the capacity they were allocated
+    /// with; spare nodes from reserve() are full ones. Moves and swaps carry the setting along,
+    /// copies start with it off.
+    void set_adaptive_capacity(bool enabled) { adaptive_ = enabled; }
+    bool adaptive_capacity() const { return adaptive_; }
+
+    /// @brief preallocate enough spare nodes that the next n elements can be inserted without
+    /// touching the allocator: every split takes a spare node and makes room for NodeMaxSize
+    /// elements, so for push_back/push_front this holds exactly. The reservation sticks: nodes
+    /// emptied by erase() or clear() refill the spare chain up to it, until shrink_to_fit().
+    void reserve(size_type n) {
+        size_type needed = (n + NodeMaxSize - 1) / NodeMaxSize;
+        reserved_nodes_ = std::max(reserved_nodes_, needed);
+        while (spare_nodes_ < needed) {
+            node* spare = allocate_node(nullptr, NodeMaxSize);
+            spare->next = spare_;
+            spare_ = spare;
+            ++spare_nodes_;
+        }
+    }
+
+    /// @brief release the spare nodes kept by reserve() and drop the reservation
+    void shrink_to_fit() {
+        reserved_nodes_ = 0;
+        while (spare_ != nullptr) {
+            sentinel_node* next = spare_->next;
+            free_node(static_cast<node*>(spare_));
+            spare_ = next;
+        }
+        spare_nodes_ = 0;
+    }
+
+#ifdef UNROLLED_LIST_ENABLE_STATS
+    /// @brief snapshot of the node layout (walks every node) plus the operation counters
+    statistics stats() const {
+        statistics result;
+        for (sentinel_node* curr = sentinel_.next; curr != sentinel(); curr = curr->next) {
+            prefetch_nodes<true>(curr);
+            size_type count = static_cast<node*>(curr)->count;
+            size_type capacity = static_cast<node*>(curr)->capacity;
+            ++result.nodes;
+            ++result.fill_histogram[count * (statistics::histogram_buckets - 1) / capacity];
+            result.bytes_used += node_bytes(capacity);
+        }
+        result.payload_bytes = size_ * sizeof(T);
+        result.splits = counters_.splits;
+        result.node_allocations = counters_.node_allocations;
+        result.node_frees = counters_.node_frees;
+        result.bytes_allocated = counters_.bytes_allocated;
+        result.element_moves = counters_.element_moves;
+        return result;
+    }
+#endif
+
+    /// @brief remembers a node and the ordinal of its first element, so positional access near the
+    /// previous one walks O(distance / NodeMaxSize) nodes instead of starting over from begin().
+    /// Lookups far from the remembered node restart from whichever end of the list is closer.
+    /// Modifications made around the cursor (not through it) invalidate it, like iterators.
+    class cursor {
+    public:
+        explicit cursor(unrolled_list& list) : list_(&list), node_(list.sentinel_.next), first_(0) {}
+
+        /// @brief iterator to the element at pos, end() for pos == size()
+        iterator at(size_type pos) {
+            if (pos > list_->size_) { throw std::out_of_range("cursor position is out of range"); }
+            seek(pos);
+            node_ = list_->unshare(node_);
+            return {node_, node_ == list_->sentinel() ? 0 : pos - first_};
+        }
+        /// @brief insert before the element at pos (pos == size() appends)
+        iterator insert(size_type pos, const T& value) {
+            iterator iter = list_->insert(at(pos), value);
+            remember(iter, pos);
+            return iter;
+        }
+        /// @brief erase the element at pos, returns an iterator to the element that takes its place
+        iterator erase(size_type pos) {
+            if (pos >= list_->size_) { throw std::out_of_range("cursor position is out of range"); }
+            iterator iter = list_->erase(at(pos));
+            remember(iter, pos);
+            return iter;
+        }
+
+        /// @brief ordinal of the first element of the remembered node
+        size_type position() const { return first_; }
+
+    private:
+        void seek(size_type pos) {
+            size_type distance = pos >= first_ ? pos - first_ : first_ - pos;
+            if (pos < distance) {
+                node_ = list_->sentinel_.next;
+                first_ = 0;
+            } else if (list_->size_ - pos < distance) {
+                node_ = list_->sentinel();
+                first_ = list_->size_;
+            }
+            while (node_ != list_->sentinel() && pos >= first_ + node_->count) {
+                first_ += node_->count;
+                node_ = node_->next;
+            }
+            while (pos < first_) {
+                node_ = node_->prev;
+                first_ -= node_->count;
+            }
+        }
+        void remember(const iterator& iter, size_type pos) {
+            node_ = iter.node;
+            first_ = pos - iter.index;
+        }
+
+        unrolled_list* list_;
+        sentinel_node* node_;
+        size_type first_;
+    };
+
+    cursor make_cursor() { return cursor(*this); }
+
     void clear() {
-        for (auto iter = --end(); iter != begin();) {
-            iter = --erase(iter);
+        for (sentinel_node* curr = sentinel_.next; curr != sentinel();) {
+            sentinel_node* next = curr->next;
+            if (drop_reference(static_cast<node*>(curr))) {
+                std::destroy_n(static_cast<node*>(curr)->data(), static_cast<node*>(curr)->count);
+                retire_node(static_cast<node*>(curr));
+            }
+            curr = next;
         }
-        erase(begin());
+        sentinel_.next = sentinel_.prev = sentinel();
+        size_ = 0;
+        nodes_ = 0;
+        short_slots_ = 0;
+        may_share_ = false;
     }
 
 private:
-    void split(iterator& iter) {
-        node* new_node = std::allocator_traits<node_allocator_type>::allocate(node_allocator, 1);
-        std::allocator_traits<node_allocator_type>::construct(node_allocator, new_node);
-        new_node->next = iter.node->next;
-        new_node->prev = iter.node;
-        new_node->next->prev = new_node;
-        iter.node->next = new_node;
+    /// @brief iterator <-> (node, index), for sorted_unrolled_list which keeps its own node index
+    static iterator make_iterator(sentinel_node* n, size_t index) { return {n, index}; }
+    static sentinel_node* node_of(const_iterator iter) { return iter.node; }
+
+    /// @brief give up the list's reference to n; true if nobody else holds it, so the caller
+    /// destroys (or reuses) it, false if a snapshot still does
+    bool drop_reference(node* n) {
+        if (!is_shared(n)) { return true; }
+        if constexpr (Snapshots) {
+            if (n->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) { return false; }
+            n->refs.store(1, std::memory_order_relaxed);  // the snapshots let go meanwhile
+        }
+        return true;
+    }
+    /// @brief whether a snapshot may hold n too; a constant false without Snapshots
+    bool is_shared(const node* n) const {
+        if constexpr (Snapshots) {
+            return may_share_ && n->refs.load(std::memory_order_acquire) != 1;
+        } else {
+            return false;
+        }
+    }
+
+    /// @brief make the linked node n safe to modify: a node shared with a snapshot is replaced by a
+    /// private copy of it. Returns the node to modify (n itself when it is not shared, or is the sentinel).
+    node* unshare(sentinel_node* n) {
+        node* shared = static_cast<node*>(n);
+        if (n == sentinel() || !is_shared(shared)) { return shared; }
+        node* copy = acquire_node(shared, shared->capacity);
         try {
-            for (size_t i = 0; i != NodeMaxSize - iter.index; ++i) {
-                new(&reinterpret_cast<T*>(new_node->data)[i]) T(reinterpret_cast<T*>(static_cast<node*>(iter.node)->data)[iter.index + i]);
-                reinterpret_cast<T*>(static_cast<node*>(iter.node)->data)[iter.index + i].~T();
+            std::uninitialized_copy_n(shared->data(), shared->count, copy->data());
+        } catch (...) {
+            retire_node(copy);
+            throw;
+        }
+        copy->count = shared->count;
+        UNROLLED_LIST_STAT(counters_.element_moves += copy->count);
+        copy->prev = shared->prev;
+        copy->next = shared->next;
+        shared->prev->next = copy;
+        shared->next->prev = copy;
+        count_unlinked(shared);
+        count_linked(copy);
+        if (drop_reference(shared)) {
+            std::destroy_n(shared->data(), shared->count);
+            retire_node(shared);
+        }
+        return copy;
+    }
+    /// @brief erase the elements [from, to) of node n, move-assigning the ones after them down once;
+    /// returns the iterator following the erased elements. Basic guarantee: if an assignment throws,
+    /// nothing is destroyed yet and the node keeps all its elements, some of them moved from.
+    iterator erase_in_node(sentinel_node* n, size_type from, size_type to) {
+        node* target = unshare(n);
+        size_type erased = to - from;
+
+        T* elements = target->data();
+        std::move(elements + to, elements + target->count, elements + from);
+        std::destroy_n(elements + target->count - erased, erased);
+        UNROLLED_LIST_STAT(counters_.element_moves += target->count - to);
+        size_ -= erased;
+        target->count -= erased;
+
+        iterator iter = {target, from};
+        if (target->count == 0) {
+            deallocate_node(iter);
+        } else if (target->count == from) {
+            iter = {target->next, 0};
+        }
+        return iter;
+    }
+
+    using kernels = unrolled_list_kernels<T>;
+
+    static const T* elements_of(const sentinel_node* n) { return static_cast<const node*>(n)->data(); }
+
+    /// @brief walk both lists in lockstep over their common length, handing visit the largest pairs of
+    /// equally long contiguous blocks; stops as soon as visit returns true
+    template<typename Visit>
+    void zip_blocks(const unrolled_list& rhs, Visit visit) const {
+        const sentinel_node* lhs_node = sentinel_.next;
+        const sentinel_node* rhs_node = rhs.sentinel_.next;
+        size_type lhs_index = 0;
+        size_type rhs_index = 0;
+        for (size_type left = std::min(size_, rhs.size_); left != 0;) {
+            size_type n = std::min({left, size_type{lhs_node->count} - lhs_index, size_type{rhs_node->count} - rhs_index});
+            if (visit(elements_of(lhs_node) + lhs_index, elements_of(rhs_node) + rhs_index, n)) { return; }
+            left -= n;
+            if ((lhs_index += n) == lhs_node->count) {
+                lhs_node = lhs_node->next;
+                lhs_index = 0;
+            }
+            if ((rhs_index += n) == rhs_node->count) {
+                rhs_node = rhs_node->next;
+                rhs_index = 0;
+            }
+        }
+    }
+
+    /// @brief equal bytes mean equal values; a class with unique object representations may still
+    /// define an operator== that ignores some of its members, so only built-in types qualify
+    static constexpr bool bytewise_comparable = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+    static ordering_type synth_three_way(const T& lhs, const T& rhs) {
+        if constexpr (std::three_way_comparable<T>) {
+            return lhs <=> rhs;
+        } else {
+            if (lhs < rhs) { return std::weak_ordering::less; }
+            if (rhs < lhs) { return std::weak_ordering::greater; }
+            return std::weak_ordering::equivalent;
+        }
+    }
+
+    template<bool Max>
+    const_iterator extreme() const {
+        const sentinel_node* best = sentinel();
+        size_t best_index = 0;
+        for (sentinel_node* curr = sentinel_.next; curr != sentinel(); curr = curr->next) {
+            prefetch_nodes<true>(curr);
+            size_t index = kernels::template extreme<Max>(elements_of(curr), curr->count);
+            const T& candidate = elements_of(curr)[index];
+            if (best == sentinel() || (Max ? elements_of(best)[best_index] < candidate : candidate < elements_of(best)[best_index])) {
+                best = curr;
+                best_index = index;
+            }
+        }
+        return {const_cast<sentinel_node*>(best), best_index};
+    }
+
+    /// @brief the mutable iterator for a position found by a const search; its node gets unshared
+    iterator writable(const_iterator iter) { return {unshare(iter.node), iter.index}; }
+
+    /// @brief inserting at iter only links a new node after iter's node, which stays untouched
+    static bool appends_to_full_node(const iterator& iter) {
+        const node* n = static_cast<node*>(iter.node);
+        return n->count == n->capacity && iter.index == n->count;
+    }
+    void unshare_all() {
+        if (!Snapshots || !may_share_) { return; }
+        for (sentinel_node* curr = sentinel_.next; curr != sentinel(); curr = curr->next) {
+            curr = unshare(curr);
+        }
+        may_share_ = false;
+    }
+
+    node_type detach_node(node* n) {
+        n->prev->next = n->next;
+        n->next->prev = n->prev;
+        count_unlinked(n);
+        size_ -= n->count;
+        return {n, node_allocator};
+    }
+
+    /// @brief after the ring was copied over from `previous` (another list's sentinel), point the
+    /// boundary nodes back at our own sentinel
+    void adopt_ring(sentinel_node& previous) {
+        if (sentinel_.next == &previous) {
+            sentinel_.next = sentinel_.prev = sentinel();
+        } else {
+            sentinel_.next->prev = sentinel();
+            sentinel_.prev->next = sentinel();
+        }
+    }
+
+    static constexpr size_type node_units(size_type capacity) {
+        return (data_offset + sizeof(T) * capacity + sizeof(node_unit) - 1) / sizeof(node_unit);
+    }
+    /// @brief bytes taken by a node that holds up to capacity elements
+    static constexpr size_type node_bytes(size_type capacity) {
+        return capacity == NodeMaxSize ? sizeof(node_storage) : node_units(capacity) * sizeof(node_unit);
+    }
+
+    /// @brief capacity of a node allocated while the list grows to size elements; at least needed
+    size_type capacity_for(size_type size, size_type needed = 1) const {
+        if (!adaptive_) { return NodeMaxSize; }
+        size_type grown = std::bit_ceil(size / 8 + 1);
+        return std::min<size_type>(NodeMaxSize, std::max({grown, min_adaptive_capacity, needed}));
+    }
+
+    /// @param hint neighbour of the new node, passed to the allocator for locality
+    /// (allocators without a hinted allocate() ignore it). A node of reduced capacity did not come
+    /// from the node allocator, so it is no hint.
+    node* allocate_node(const sentinel_node* hint, size_type capacity) {
+        void* storage;
+        if (capacity == NodeMaxSize) {
+            if (hint != nullptr && hint->capacity != NodeMaxSize) { hint = nullptr; }
+            storage = std::allocator_traits<node_allocator_type>::allocate(node_allocator, 1, hint);
+        } else {
+            unit_allocator_type units(node_allocator);
+            storage = std::allocator_traits<unit_allocator_type>::allocate(units, node_units(capacity));
+        }
+        node* new_node = new (storage) node;  // only the header; elements are constructed as they arrive
+        new_node->capacity = static_cast<count_type>(capacity);
+        UNROLLED_LIST_STAT(++counters_.node_allocations);
+        UNROLLED_LIST_STAT(counters_.bytes_allocated += node_bytes(capacity));
+        return new_node;
+    }
+    /// @brief destroy n's header (not its elements) and give its storage back the way allocate_node() got it
+    static void release_node(node_allocator_type& alloc, node* n) {
+        size_type capacity = n->capacity;
+        n->~node();
+        if (capacity == NodeMaxSize) {
+            std::allocator_traits<node_allocator_type>::deallocate(alloc, reinterpret_cast<node_storage*>(n), 1);
+        } else {
+            unit_allocator_type units(alloc);
+            std::allocator_traits<unit_allocator_type>::deallocate(units, reinterpret_cast<node_unit*>(n), node_units(capacity));
+        }
+    }
+    void free_node(node* n) {
+        release_node(node_allocator, n);
+        UNROLLED_LIST_STAT(++counters_.node_frees);
+    }
+    /// @brief an emptied node goes to the spare chain if reserve() asked for more spares, else it is
+    /// freed; only full nodes are kept as spares
+    void retire_node(node* n) {
+        if (n->capacity != NodeMaxSize || spare_nodes_ >= reserved_nodes_) { free_node(n); return; }
+        n->count = 0;
+        n->next = spare_;
+        spare_ = n;
+        ++spare_nodes_;
+    }
+    /// @brief a spare node from reserve() if there is one (a full one, so at least capacity), a freshly
+    /// allocated one of the given capacity otherwise
+    node* acquire_node(const sentinel_node* hint, size_type capacity) {
+        if (spare_ == nullptr) { return allocate_node(hint, capacity); }
+        node* result = static_cast<node*>(spare_);
+        spare_ = spare_->next;
+        --spare_nodes_;
+        return result;
+    }
+
+    /// @brief keep nodes_ and short_slots_ in step with n being linked into / unlinked from the ring
+    void count_linked(const node* n) {
+        ++nodes_;
+        short_slots_ += NodeMaxSize - n->capacity;
+    }
+    void count_unlinked(const node* n) {
+        --nodes_;
+        short_slots_ -= NodeMaxSize - n->capacity;
+    }
+
+    /// @brief nodes linked through next/prev whose outer links are not set yet
+    struct node_chain {
+        node* head = nullptr;
+        node* tail = nullptr;
+    };
+
+    /// @brief copy-construct n elements from first into data[from, from + n) of target; on exception
+    /// the elements constructed by this call are destroyed
+    template<typename Iterator>
+    void construct_elements(node* target, size_type from, Iterator& first, size_type n) {
+        T* out = target->data() + from;
+        if constexpr (std::contiguous_iterator<Iterator> && std::is_trivially_copyable_v<T> &&
+                      std::is_same_v<std::remove_cv_t<std::iter_value_t<Iterator>>, T>) {
+            std::memcpy(static_cast<void*>(out), std::to_address(first), n * sizeof(T));
+            first += n;
+        } else {
+            size_type i = 0;
+            try {
+                for (; i != n; ++i, ++first) { new (out + i) T(*first); }
+            } catch (...) {
+                std::destroy_n(out, i);
+                throw;
+            }
+        }
+    }
+
+    void destroy_chain(node_chain& chain) {
+        for (node* curr = chain.head; curr != nullptr;) {
+            node* next = curr == chain.tail ? nullptr : static_cast<node*>(curr->next);
+            std::destroy_n(curr->data(), curr->count);
+            free_node(curr);
+            curr = next;
+        }
+        chain = {};
+    }
+
+    /// @brief n elements from first packed into full nodes (the last one may be partial)
+    template<typename Iterator>
+    node_chain build_chain(Iterator& first, size_type n, const sentinel_node* hint) {
+        node_chain chain;
+        size_type capacity = capacity_for(size_ + n);
+        try {
+            while (n != 0) {
+                node* curr = acquire_node(chain.tail != nullptr ? chain.tail : hint, capacity);
+                curr->count = 0;
+                if (chain.head == nullptr) {
+                    chain.head = curr;
+                } else {
+                    chain.tail->next = curr;
+                    curr->prev = chain.tail;
+                }
+                chain.tail = curr;
+                size_type k = std::min<size_type>(n, curr->capacity);
+                construct_elements(curr, 0, first, k);
+                curr->count = k;
+                n -= k;
             }
         } catch (...) {
-            iter.node->next = new_node->next;
-            std::allocator_traits<node_allocator_type>::destroy(node_allocator, new_node);
-            std::allocator_traits<node_allocator_type>::deallocate(node_allocator, new_node, 1);
+            destroy_chain(chain);
             throw;
         }
-        new_node->count = NodeMaxSize - iter.index;
-        if (new_node->count == 0) {
-            iter.node = new_node;
-            iter.index = 0;
+        return chain;
+    }
+
+    /// @brief link chain between the adjacent `after` and `before`; the chain's nodes are counted into nodes_
+    void link_chain(sentinel_node* after, sentinel_node* before, node_chain& chain) {
+        for (sentinel_node* curr = chain.head; ; curr = curr->next) {
+            count_linked(static_cast<node*>(curr));
+            if (curr == chain.tail) { break; }
+        }
+        chain.head->prev = after;
+        chain.tail->next = before;
+        before->prev = chain.tail;
+        after->next = chain.head;
+    }
+
+    template<typename Iterator>
+    iterator insert_sized(const_iterator pos, Iterator first, size_type n) {
+        iterator iter = {pos.node, pos.index};
+        if (n == 0) { return iter; }
+        if (size_ == 0) {
+            node_chain chain = build_chain(first, n, nullptr);
+            link_chain(sentinel(), sentinel(), chain);
+            size_ = n;
+            return {chain.head, 0};
+        }
+        if (iter.node == sentinel()) {
+            iter.node = iter.node->prev;
+            iter.index = static_cast<node*>(iter.node)->count;
+        }
+        if (!appends_to_full_node(iter)) { iter.node = unshare(iter.node); }
+        node* target = static_cast<node*>(iter.node);
+
+        // appending to a node: fill its free slots first
+        size_type top_up = iter.index == target->count ? std::min<size_type>(n, target->capacity - target->count) : 0;
+        construct_elements(target, target->count, first, top_up);
+        target->count += top_up;
+
+        node_chain chain;
+        try {
+            chain = build_chain(first, n - top_up, target);
+            if (chain.head != nullptr && top_up == 0 && iter.index != 0 && iter.index < target->count) {
+                split(iter);
+            }
+        } catch (...) {
+            destroy_chain(chain);
+            target->count -= top_up;
+            std::destroy_n(target->data() + target->count, top_up);
+            throw;
+        }
+        size_ += n;
+
+        if (top_up != 0) {
+            if (chain.head != nullptr) { link_chain(target, target->next, chain); }
+            return {target, target->count - top_up};
+        }
+        if (iter.index == 0) {  // the chain goes in front of target
+            link_chain(target->prev, target, chain);
+        } else {
+            link_chain(target, target->next, chain);
+        }
+        return {chain.head, 0};
+    }
+
+    /// @brief link a fresh node holding just value after `after`; on exception nothing changed
+    iterator insert_new_node(sentinel_node* after, const sentinel_node* hint, const T& value) {
+        node* fresh = acquire_node(hint, capacity_for(size_ + 1));
+        try {
+            new (fresh->data()) T(value);
+        } catch (...) {
+            retire_node(fresh);
+            throw;
         }
-        static_cast<node*>(iter.node)->count = iter.index;
+        fresh->count = 1;
+        fresh->prev = after;
+        fresh->next = after->next;
+        after->next->prev = fresh;
+        after->next = fresh;
+        count_linked(fresh);
+        ++size_;
+        return {fresh, 0};
+    }
+    /// @brief construct value in the free slot after the last element of target
+    template<typename V>
+    void construct_back(node* target, V&& value) {
+        new (target->data() + target->count) T(std::forward<V>(value));
+        ++target->count;
+        ++size_;
+    }
+
+    /// @brief move the elements [iter.index, count) of iter's node, at least one, into a new node linked
+    /// after it. All of them are copied before any original is destroyed, so on exception the list is unchanged.
+    void split(iterator& iter) {
+        node* source = static_cast<node*>(iter.node);
+        size_t moved = source->count - iter.index;
+        node* new_node = acquire_node(source, capacity_for(size_ + 1, moved));
+        T* from = source->data() + iter.index;
+        T* to = new_node->data();
+        size_t copied = 0;
+        try {
+            for (; copied != moved; ++copied) {
+                new (to + copied) T(from[copied]);
+            }
+        } catch (...) {
+            std::destroy_n(to, copied);
+            retire_node(new_node);
+            throw;
+        }
+        std::destroy_n(from, moved);
+
+        count_linked(new_node);
+        new_node->next = source->next;
+        new_node->prev = source;
+        new_node->next->prev = new_node;
+        source->next = new_node;
+        new_node->count = moved;
+        UNROLLED_LIST_STAT(++counters_.splits);
+        UNROLLED_LIST_STAT(counters_.element_moves += new_node->count);
+        source->count = iter.index;
     }
     void deallocate_node(iterator& iter) {
-        if (iter.node == begin_ && size_ == 0) { iter = end(); return; }
-        if (iter.node == begin_) { begin_ = iter.node->next; }
         iter.node->prev->next = iter.node->next;
         iter.node->next->prev = iter.node->prev;
         sentinel_node* next_node = iter.node->next;
-        std::allocator_traits<node_allocator_type>::destroy(node_allocator, static_cast<node*>(iter.node));
-        std::allocator_traits<node_allocator_type>::deallocate(node_allocator, static_cast<node*>(iter.node), 1);
+        count_unlinked(static_cast<node*>(iter.node));
+        retire_node(static_cast<node*>(iter.node));
         iter.node = next_node;
         iter.index = 0;
     }
 
 public:
+    /// @brief insert value before pos. Going in front of or after a full node, value gets a fresh
+    /// node and the full one is left as it is; inside a full node the node is split first. Strong
+    /// guarantee, except that a split stays when copying value throws, and that for T whose moves
+    /// may throw an exception from moving value into place leaves it in the node (basic guarantee).
     iterator insert(const_iterator const_iter, const T& value) {
         iterator iter(const_iter.node, const_iter.index);
-        if (iter.node->is_sentinel) {
+        if (size_ == 0) { return insert_new_node(sentinel(), nullptr, value); }
+        if (iter.node == sentinel()) {
             iter.node = iter.node->prev;
             iter.index = static_cast<node*>(iter.node)->count;
         }
+        node* target = static_cast<node*>(iter.node);
+        if (target->count == target->capacity && (iter.index == 0 || iter.index == target->count)) {
+            UNROLLED_LIST_STAT(++counters_.splits);
+            return insert_new_node(iter.index == 0 ? target->prev : target, target, value);
+        }
+        iter.node = target = unshare(target);
+        if (target->count == target->capacity) {
+            T copy(value);  // value may be one of the elements split() moves
+            split(iter);    // iter is now the end of target, which has room
+            construct_back(target, std::move_if_noexcept(copy));
+            return iter;
+        }
+        if (iter.index == target->count) {
+            construct_back(target, value);
+            return iter;
+        }
 
-        alignas(T) unsigned char buffer[sizeof(T) * NodeMaxSize];
-        std::copy(static_cast<node*>(iter.node)->data, static_cast<node*>(iter.node)->data + sizeof(T) * NodeMaxSize, buffer);
-
-        size_type i = 0;
-        try {
-            if (static_cast<node*>(iter.node)->count == NodeMaxSize) {
-                split(iter);
-            }
-            node* iter_node = static_cast<node*>(iter.node);
-            for (; i != iter_node->count - iter.index; ++i) {
-                new (&reinterpret_cast<T*>(iter_node->data)[iter_node->count - i]) T(reinterpret_cast<T*>(iter_node->data)[iter_node->count - i - 1]);
-                reinterpret_cast<T*>(iter_node->data)[iter_node->count - i - 1].~T();
+        T* elements = target->data();
+        UNROLLED_LIST_STAT(counters_.element_moves += target->count - iter.index);
+        if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            T copy(value);  // value may be one of the elements moved below
+            for (size_type i = target->count; i != iter.index; --i) {
+                new (elements + i) T(std::move(elements[i - 1]));
+                elements[i - 1].~T();
             }
-            new (&*iter) T(value);
+            new (elements + iter.index) T(std::move(copy));
+            ++target->count;
             ++size_;
-            ++iter_node->count;
-        } catch (...) {
-            for (size_type j = 0; j != i; ++j) {
-                reinterpret_cast<T*>(static_cast<node*>(iter.node)->data)[static_cast<node*>(iter.node)->count - i].~T();
-            }
-            std::copy(buffer, buffer + sizeof(T) * NodeMaxSize, static_cast<node*>(iter.node)->data);
-            throw;
+        } else {
+            // moving may throw, so never leave a hole: copy value into the free slot, then rotate it into place
+            construct_back(target, value);
+            std::rotate(elements + iter.index, elements + target->count - 1, elements + target->count);
         }
         return iter;
     }
@@ -320,52 +1466,146 @@ public:
         while (begin != end) { iter = insert(iter, *begin++); ++iter; }
         return copy;
     }
-    iterator insert(const_iterator const_iter, std::initializer_list<T> il) {
-        iterator iter = {const_iter.node, const_iter.index};
-        iterator copy = iter;
-        for (auto i = il.begin(); i != il.end(); ++i) {
-            iter = insert(iter, *i);
-            if (i == il.begin()) { copy = iter; }
-            ++iter;
+    iterator insert(const_iterator const_iter, std::initializer_list<T> il) { return insert_range(const_iter, il); }
+
+    /// @brief insert the elements of rg before pos, returns an iterator to the first inserted one.
+    /// Sized (or forward) ranges are copied straight into fresh full nodes that are linked in at
+    /// once; inserting at the end of a node first fills its free slots. Strong guarantee.
+    template<unrolled_list_compatible_range<T> R>
+    iterator insert_range(const_iterator pos, R&& rg) {
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>) {
+            return insert_sized(pos, std::ranges::begin(rg), static_cast<size_type>(std::ranges::distance(rg)));
+        } else {
+            iterator iter = {pos.node, pos.index};
+            iterator first = iter;
+            bool inserted = false;
+            for (auto&& value : rg) {
+                iter = insert(iter, value);
+                if (!inserted) { first = iter; inserted = true; }
+                ++iter;
+            }
+            return first;
         }
-        return copy;
+    }
+    template<unrolled_list_compatible_range<T> R>
+    void append_range(R&& rg) { insert_range(cend(), std::forward<R>(rg)); }
+    template<unrolled_list_compatible_range<T> R>
+    void prepend_range(R&& rg) { insert_range(cbegin(), std::forward<R>(rg)); }
+    template<unrolled_list_compatible_range<T> R>
+    void assign_range(R&& rg) {
+        clear();
+        append_range(std::forward<R>(rg));
     }
 
     iterator erase(const_iterator const_iter) {
-        if (const_iter == end() || (const_iter == begin() && size_ == 0)) return end();
-        iterator iter = {const_iter.node, const_iter.index};
+        if (const_iter.node == sentinel()) { return {sentinel(), 0}; }
+        return erase_in_node(const_iter.node, const_iter.index, const_iter.index + 1);
+    }
+    /// @brief erase [first, last), returns the iterator following the erased elements. The survivors
+    /// of last's node shift down once, the nodes in between are destroyed whole without shifting and
+    /// first's node just loses its tail: O(erased + NodeMaxSize).
+    iterator erase(const_iterator first, const_iterator last) {
+        if (first == last) { return {last.node, last.index}; }
+        if (first.node == last.node) { return erase_in_node(first.node, first.index, last.index); }
 
-        alignas(T) unsigned char buffer[sizeof(T) * NodeMaxSize];
-        std::copy(static_cast<node*>(iter.node)->data, static_cast<node*>(iter.node)->data + sizeof(T) * NodeMaxSize, buffer);
+        // unsharing the two partly erased nodes and shifting last's survivors may throw: all of it
+        // comes before anything else is destroyed, so a throw leaves every element in the list
+        node* head = first.index != 0 ? unshare(first.node) : nullptr;
+        sentinel_node* tail = last.node;
+        if (tail != sentinel() && last.index != 0) {
+            tail = unshare(tail);
+            tail = erase_in_node(tail, 0, last.index).node;
+        }
 
-        node* casted_node = static_cast<node*>(iter.node);
-        size_type i = iter.index;
-        try {
-            for (; i != casted_node->count; ++i) {
-                if (i != iter.index) {
-                    new (&reinterpret_cast<T*>(casted_node->data)[i - 1]) T(reinterpret_cast<T*>(casted_node->data)[i]);
-                }
-                reinterpret_cast<T*>(casted_node->data)[i].~T();
-            }
-        } catch(...) {
-            for (size_type j = 0; j != i; ++j) {
-                reinterpret_cast<T*>(static_cast<node*>(iter.node)->data)[iter.index + i].~T();
+        // unshare() may have dropped the list's reference to first.node, so only read it if it was kept
+        sentinel_node* keep = head != nullptr ? head : first.node->prev;
+        if (head != nullptr) {
+            std::destroy_n(head->data() + first.index, head->count - first.index);
+            size_ -= head->count - first.index;
+            head->count = first.index;
+        }
+        for (sentinel_node* curr = keep->next; curr != tail;) {
+            sentinel_node* next = curr->next;
+            node* dropped = static_cast<node*>(curr);
+            size_ -= dropped->count;
+            count_unlinked(dropped);
+            if (drop_reference(dropped)) {
+                std::destroy_n(dropped->data(), dropped->count);
+                retire_node(dropped);
             }
-            std::copy(buffer, buffer + sizeof(T) * NodeMaxSize, static_cast<node*>(iter.node)->data);
-            throw;
+            curr = next;
         }
-        --size_; --casted_node->count;
-        if (casted_node->count == 0) deallocate_node(iter);
-        else if (casted_node->count == iter.index) {
-            iter.node = iter.node->next;
+        keep->next = tail;
+        tail->prev = keep;
+        return {tail, 0};
+    }
+
+    /// @brief detach the first node together with its elements; an empty handle if the list is empty.
+    /// No element is copied or moved.
+    node_type extract_front_node() {
+        if (size_ == 0) { return {}; }
+        return detach_node(unshare(sentinel_.next));
+    }
+    /// @brief detach the whole node that holds *pos (not just that element); an empty handle for end()
+    node_type extract_node(const_iterator pos) {
+        if (pos.node == sentinel()) { return {}; }
+        return detach_node(unshare(pos.node));
+    }
+    /// @brief link the node of nh in before pos and return an iterator to its first element.
+    /// Inserting inside a node first splits it at pos; otherwise no element is copied or moved.
+    /// Throws std::invalid_argument if nh's allocator does not compare equal to this list's.
+    iterator insert_node(const_iterator pos, node_type&& nh) {
+        iterator iter = {pos.node, pos.index};
+        if (nh.empty()) { return iter; }
+        if (!(nh.node_allocator_ == node_allocator)) { throw std::invalid_argument("node handle allocator is not compatible with the list"); }
+        if (iter.node == sentinel()) {
             iter.index = 0;
+        } else if (iter.index != 0) {
+            iter.node = unshare(iter.node);
+            split(iter);
+            iter = {iter.node->next, 0};
         }
-        return iter;
+        node* n = std::exchange(nh.node_, nullptr);
+        n->prev = iter.node->prev;
+        n->next = iter.node;
+        iter.node->prev->next = n;
+        iter.node->prev = n;
+        count_linked(n);
+        size_ += n->count;
+        return {n, 0};
     }
-    iterator erase(const_iterator begin, const_iterator end) {
-        iterator iter = {begin.node, begin.index};
-        while (iter != end && iter != end()) { iter = erase(iter); }
-        return iter;
+
+    /// @brief move every node of other in before pos and return an iterator to the first moved element
+    /// (pos if other is empty). Only the boundary links change, plus a split of pos's node when pos
+    /// is inside one; no element is copied or moved. other keeps its spare nodes and ends up empty.
+    /// Throws std::invalid_argument for other == *this or if the allocators do not compare equal.
+    iterator splice(const_iterator pos, unrolled_list&& other) {
+        iterator iter = {pos.node, pos.index};
+        if (&other == this) { throw std::invalid_argument("cannot splice a list into itself"); }
+        if (other.size_ == 0) { return iter; }
+        if (!(other.node_allocator == node_allocator)) { throw std::invalid_argument("spliced list allocator is not compatible with the list"); }
+        if (iter.node == sentinel()) {
+            iter.index = 0;
+        } else if (iter.index != 0) {
+            iter.node = unshare(iter.node);
+            split(iter);
+            iter = {iter.node->next, 0};
+        }
+        sentinel_node* first = other.sentinel_.next;
+        sentinel_node* last = other.sentinel_.prev;
+        first->prev = iter.node->prev;
+        last->next = iter.node;
+        iter.node->prev->next = first;
+        iter.node->prev = last;
+        size_ += other.size_;
+        nodes_ += other.nodes_;
+        short_slots_ += other.short_slots_;
+        may_share_ = may_share_ || other.may_share_;
+
+        other.sentinel_.next = other.sentinel_.prev = other.sentinel();
+        other.size_ = other.nodes_ = other.short_slots_ = 0;
+        other.may_share_ = false;
+        return {first, 0};
     }
 
     template<typename InputIterator>
@@ -379,15 +1619,21 @@ public:
         for (size_type i = 0; i != n; ++i) { push_back(value); }
     }
 
-    void push_back(const T& value) { insert(end(), value); }
-    void push_front(const T& value) { insert(begin(), value); }
+    void push_back(const T& value) { insert(cend(), value); }
+    void push_front(const T& value) { insert(cbegin(), value); }
 
-    void pop_front() { erase(begin()); }
-    void pop_back() { erase(--end()); }
+    void pop_front() { erase(cbegin()); }
+    void pop_back() { erase(--cend()); }
 
-    reference front() { return *begin(); }
+    reference front() {
+        unshare(sentinel_.next);
+        return *iterator(sentinel_.next, 0);
+    }
     const_reference front() const { return *begin(); }
 
-    reference back() { return *(--end()); }
+    reference back() {
+        unshare(sentinel_.prev);
+        return *(--iterator(sentinel(), 0));
+    }
     const_reference back() const { return *(--end()); }
 };
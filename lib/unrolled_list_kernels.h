@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/// Vectorized kernels are compiled for x86 with GCC/Clang (AVX2 picked at run time, SSE2 as the
+/// baseline). Define UNROLLED_LIST_DISABLE_SIMD to force the plain loops, e.g. to compare.
+#if !defined(UNROLLED_LIST_DISABLE_SIMD) && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define UNROLLED_LIST_X86_KERNELS 1
+#define UNROLLED_LIST_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+/// @brief search kernels over one node's block of elements data[0, n), behind unrolled_list::find,
+/// count, contains, min_element and max_element.
+///
+/// For arithmetic T of 1, 2, 4 or 8 bytes find/count compare 32 bytes at a time with AVX2 when the
+/// CPU has it (checked once), 16 bytes with SSE2 otherwise. min/max of integers up to 4 bytes reduce
+/// with AVX2 and then find the first position of the extreme value; floating point min/max stay
+/// scalar so NaN behaves as in std::min_element. Every other T, and targets without the
+/// intrinsics, use the plain loops.
+template<typename T>
+struct unrolled_list_kernels {
+    /// @brief position of the first element equal to value, n if there is none
+    static size_t find(const T* data, size_t n, const T& value) {
+#ifdef UNROLLED_LIST_X86_KERNELS
+        if constexpr (searchable) {
+            if (has_avx2()) { return find_avx2(data, n, value); }
+#ifdef __SSE2__
+            if constexpr (sse2_searchable) { return find_sse2(data, n, value); }
+#endif
+        }
+#endif
+        return find_scalar(data, 0, n, value);
+    }
+
+    static size_t count(const T* data, size_t n, const T& value) {
+#ifdef UNROLLED_LIST_X86_KERNELS
+        if constexpr (searchable) {
+            if (has_avx2()) { return count_avx2(data, n, value); }
+#ifdef __SSE2__
+            if constexpr (sse2_searchable) { return count_sse2(data, n, value); }
+#endif
+        }
+#endif
+        return count_scalar(data, 0, n, value);
+    }
+
+    /// @brief position of the first smallest (Max: largest) element by operator<; n must not be 0
+    template<bool Max>
+    static size_t extreme(const T* data, size_t n) {
+#ifdef UNROLLED_LIST_X86_KERNELS
+        if constexpr (reducible) {
+            if (has_avx2()) { return extreme_avx2<Max>(data, n); }
+        }
+#endif
+        return extreme_scalar<Max>(data, n);
+    }
+
+private:
+    static constexpr bool searchable = std::is_arithmetic_v<T> &&
+        (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) &&
+        (std::is_integral_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>);
+    // SSE2 has no 64-bit integer equality
+    static constexpr bool sse2_searchable = searchable && !(std::is_integral_v<T> && sizeof(T) == 8);
+    static constexpr bool reducible = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 4;
+
+    static size_t find_scalar(const T* data, size_t from, size_t n, const T& value) {
+        for (size_t i = from; i != n; ++i) {
+            if (data[i] == value) { return i; }
+        }
+        return n;
+    }
+    static size_t count_scalar(const T* data, size_t from, size_t n, const T& value) {
+        size_t result = 0;
+        for (size_t i = from; i != n; ++i) {
+            result += data[i] == value;
+        }
+        return result;
+    }
+    template<bool Max>
+    static size_t extreme_scalar(const T* data, size_t n) {
+        size_t best = 0;
+        T value = data[0];  // kept in a register, not reloaded through best
+        for (size_t i = 1; i != n; ++i) {
+            if (Max ? value < data[i] : data[i] < value) {
+                value = data[i];
+                best = i;
+            }
+        }
+        return best;
+    }
+
+#ifdef UNROLLED_LIST_X86_KERNELS
+    static bool has_avx2() {
+        static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+        return supported;
+    }
+
+    // masks below have one bit per byte, so sizeof(T) bits per element
+
+    UNROLLED_LIST_TARGET_AVX2 static __m256i splat_avx2(const T& value) {
+        if constexpr (std::is_same_v<T, float>) { return _mm256_castps_si256(_mm256_set1_ps(value)); }
+        else if constexpr (std::is_same_v<T, double>) { return _mm256_castpd_si256(_mm256_set1_pd(value)); }
+        else if constexpr (sizeof(T) == 1) { return _mm256_set1_epi8(static_cast<char>(value)); }
+        else if constexpr (sizeof(T) == 2) { return _mm256_set1_epi16(static_cast<short>(value)); }
+        else if constexpr (sizeof(T) == 4) { return _mm256_set1_epi32(static_cast<int>(value)); }
+        else { return _mm256_set1_epi64x(static_cast<long long>(value)); }
+    }
+    UNROLLED_LIST_TARGET_AVX2 static uint32_t equal_mask_avx2(const T* p, __m256i splat) {
+        if constexpr (std::is_same_v<T, float>) {
+            __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(p), _mm256_castsi256_ps(splat), _CMP_EQ_OQ);
+            return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_castps_si256(eq)));
+        } else if constexpr (std::is_same_v<T, double>) {
+            __m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(p), _mm256_castsi256_pd(splat), _CMP_EQ_OQ);
+            return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_castpd_si256(eq)));
+        } else {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            __m256i eq;
+            if constexpr (sizeof(T) == 1) { eq = _mm256_cmpeq_epi8(block, splat); }
+            else if constexpr (sizeof(T) == 2) { eq = _mm256_cmpeq_epi16(block, splat); }
+            else if constexpr (sizeof(T) == 4) { eq = _mm256_cmpeq_epi32(block, splat); }
+            else { eq = _mm256_cmpeq_epi64(block, splat); }
+            return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        }
+    }
+    UNROLLED_LIST_TARGET_AVX2 static size_t find_avx2(const T* data, size_t n, const T& value) {
+        constexpr size_t lanes = 32 / sizeof(T);
+        __m256i splat = splat_avx2(value);
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            uint32_t mask = equal_mask_avx2(data + i, splat);
+            if (mask != 0) { return i + static_cast<size_t>(__builtin_ctz(mask)) / sizeof(T); }
+        }
+        return find_scalar(data, i, n, value);
+    }
+    UNROLLED_LIST_TARGET_AVX2 static size_t count_avx2(const T* data, size_t n, const T& value) {
+        constexpr size_t lanes = 32 / sizeof(T);
+        __m256i splat = splat_avx2(value);
+        size_t bits = 0;
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            bits += static_cast<size_t>(__builtin_popcount(equal_mask_avx2(data + i, splat)));
+        }
+        return bits / sizeof(T) + count_scalar(data, i, n, value);
+    }
+
+    template<bool Max>
+    UNROLLED_LIST_TARGET_AVX2 static __m256i pick_avx2(__m256i a, __m256i b) {
+        if constexpr (std::is_signed_v<T>) {
+            if constexpr (sizeof(T) == 1) { return Max ? _mm256_max_epi8(a, b) : _mm256_min_epi8(a, b); }
+            else if constexpr (sizeof(T) == 2) { return Max ? _mm256_max_epi16(a, b) : _mm256_min_epi16(a, b); }
+            else { return Max ? _mm256_max_epi32(a, b) : _mm256_min_epi32(a, b); }
+        } else {
+            if constexpr (sizeof(T) == 1) { return Max ? _mm256_max_epu8(a, b) : _mm256_min_epu8(a, b); }
+            else if constexpr (sizeof(T) == 2) { return Max ? _mm256_max_epu16(a, b) : _mm256_min_epu16(a, b); }
+            else { return Max ? _mm256_max_epu32(a, b) : _mm256_min_epu32(a, b); }
+        }
+    }
+    template<bool Max>
+    UNROLLED_LIST_TARGET_AVX2 static size_t extreme_avx2(const T* data, size_t n) {
+        constexpr size_t lanes = 32 / sizeof(T);
+        if (n < lanes) { return extreme_scalar<Max>(data, n); }
+        __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        size_t i = lanes;
+        for (; i + lanes <= n; i += lanes) {
+            best = pick_avx2<Max>(best, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+        }
+        alignas(32) T reduced[lanes];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(reduced), best);
+        T value = reduced[extreme_scalar<Max>(reduced, lanes)];
+        for (; i != n; ++i) {
+            if (Max ? value < data[i] : data[i] < value) { value = data[i]; }
+        }
+        return find_avx2(data, n, value);
+    }
+
+#ifdef __SSE2__
+    static __m128i splat_sse2(const T& value) {
+        if constexpr (std::is_same_v<T, float>) { return _mm_castps_si128(_mm_set1_ps(value)); }
+        else if constexpr (std::is_same_v<T, double>) { return _mm_castpd_si128(_mm_set1_pd(value)); }
+        else if constexpr (sizeof(T) == 1) { return _mm_set1_epi8(static_cast<char>(value)); }
+        else if constexpr (sizeof(T) == 2) { return _mm_set1_epi16(static_cast<short>(value)); }
+        else { return _mm_set1_epi32(static_cast<int>(value)); }
+    }
+    static uint32_t equal_mask_sse2(const T* p, __m128i splat) {
+        if constexpr (std::is_same_v<T, float>) {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(p), _mm_castsi128_ps(splat)))));
+        } else if constexpr (std::is_same_v<T, double>) {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(p), _mm_castsi128_pd(splat)))));
+        } else {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i eq;
+            if constexpr (sizeof(T) == 1) { eq = _mm_cmpeq_epi8(block, splat); }
+            else if constexpr (sizeof(T) == 2) { eq = _mm_cmpeq_epi16(block, splat); }
+            else { eq = _mm_cmpeq_epi32(block, splat); }
+            return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+        }
+    }
+    static size_t find_sse2(const T* data, size_t n, const T& value) {
+        constexpr size_t lanes = 16 / sizeof(T);
+        __m128i splat = splat_sse2(value);
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            uint32_t mask = equal_mask_sse2(data + i, splat);
+            if (mask != 0) { return i + static_cast<size_t>(__builtin_ctz(mask)) / sizeof(T); }
+        }
+        return find_scalar(data, i, n, value);
+    }
+    static size_t count_sse2(const T* data, size_t n, const T& value) {
+        constexpr size_t lanes = 16 / sizeof(T);
+        __m128i splat = splat_sse2(value);
+        size_t bits = 0;
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            bits += static_cast<size_t>(__builtin_popcount(equal_mask_sse2(data + i, splat)));
+        }
+        return bits / sizeof(T) + count_scalar(data, i, n, value);
+    }
+#endif
+#endif
+};
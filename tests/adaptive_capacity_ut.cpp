@@ -0,0 +1,178 @@
+#include <unrolled_list.h>
+#include <slab_allocator.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using AdaptiveList = unrolled_list<int, 64>;
+
+/*
+    Тесты для адаптивной вместимости узлов (set_adaptive_capacity): маленький список
+    выделяет маленькие узлы, по мере роста вместимость новых узлов удваивается до NodeMaxSize.
+    Вставка, разбиение узлов, удаление, снимки и дескрипторы узлов должны работать
+    с узлами разной вместимости.
+*/
+
+TEST(AdaptiveCapacity, OffByDefault) {
+    unrolled_list<int, 64> list = {1, 2, 3};
+    ASSERT_FALSE(list.adaptive_capacity());
+    ASSERT_EQ(list.capacity(), 64);
+}
+
+TEST(AdaptiveCapacity, SmallListTakesSmallNodes) {
+    unrolled_list<int, 64> list;
+    list.set_adaptive_capacity(true);
+    for (int i = 0; i != 3; ++i) {
+        list.push_back(i);
+    }
+    ASSERT_EQ(list.capacity(), AdaptiveList::min_adaptive_capacity);
+    ASSERT_THAT(list, ::testing::ElementsAre(0, 1, 2));
+
+    list.push_back(3);
+    list.push_back(4);
+    ASSERT_EQ(list.capacity(), 8);
+    ASSERT_THAT(list, ::testing::ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST(AdaptiveCapacity, NodesGrowUpToNodeMaxSize) {
+    unrolled_list<int, 64> list;
+    list.set_adaptive_capacity(true);
+    std::vector<int> expected;
+    for (int i = 0; i != 5000; ++i) {
+        list.push_back(i);
+        expected.push_back(i);
+        ASSERT_LT(list.capacity() - list.size(), 64);
+    }
+    ASSERT_TRUE(std::ranges::equal(list, expected));
+
+    // the first nodes stay small, later ones are full-size
+    auto blocks = std::as_const(list).nodes();
+    ASSERT_EQ((*blocks.begin()).size(), AdaptiveList::min_adaptive_capacity);
+    ASSERT_EQ((*std::ranges::next(blocks.begin(), 50)).size(), 64);
+}
+
+TEST(AdaptiveCapacity, BulkInsertUsesLargeNodes) {
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    unrolled_list<int, 32> list;
+    list.set_adaptive_capacity(true);
+    list.append_range(values);
+    ASSERT_EQ(list.capacity(), 1024);
+    ASSERT_TRUE(std::ranges::equal(list, values));
+}
+
+TEST(AdaptiveCapacity, RandomInsertsAndErasesMatchVector) {
+    unrolled_list<int, 16> list;
+    list.set_adaptive_capacity(true);
+    std::vector<int> expected;
+    std::mt19937 gen(43);
+    for (int step = 0; step != 20000; ++step) {
+        if (expected.empty() || gen() % 3 != 0) {
+            size_t pos = gen() % (expected.size() + 1);
+            list.insert(std::next(list.begin(), static_cast<std::ptrdiff_t>(pos)), step);
+            expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), step);
+        } else {
+            size_t pos = gen() % expected.size();
+            size_t n = std::min<size_t>(gen() % 20 + 1, expected.size() - pos);
+            auto first = std::next(list.begin(), static_cast<std::ptrdiff_t>(pos));
+            list.erase(first, std::next(first, static_cast<std::ptrdiff_t>(n)));
+            expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(pos), expected.begin() + static_cast<std::ptrdiff_t>(pos + n));
+        }
+        ASSERT_EQ(list.size(), expected.size());
+        ASSERT_GE(list.capacity(), list.size());
+    }
+    ASSERT_TRUE(std::ranges::equal(list, expected));
+}
+
+TEST(AdaptiveCapacity, CapacityFollowsFreedNodes) {
+    unrolled_list<int, 64> list;
+    list.set_adaptive_capacity(true);
+    for (int i = 0; i != 200; ++i) {
+        list.push_back(i);
+    }
+    while (!list.empty()) {
+        list.pop_front();
+        ASSERT_LT(list.capacity() - list.size(), 2 * 64);
+    }
+    ASSERT_EQ(list.capacity(), 0);
+}
+
+TEST(AdaptiveCapacity, ReserveKeepsFullSpares) {
+    unrolled_list<int, 16> list;
+    list.set_adaptive_capacity(true);
+    list.reserve(40);
+    ASSERT_EQ(list.capacity(), 48);
+    list.push_back(1);
+    ASSERT_EQ(list.capacity(), 48);
+    list.clear();
+    list.shrink_to_fit();
+    ASSERT_EQ(list.capacity(), 0);
+}
+
+TEST(AdaptiveCapacity, CopiesStartOffMovesCarryIt) {
+    unrolled_list<int, 64> list = {1, 2, 3};
+    list.set_adaptive_capacity(true);
+    list.push_back(4);
+
+    unrolled_list<int, 64> copy = list;
+    ASSERT_FALSE(copy.adaptive_capacity());
+    ASSERT_EQ(copy, list);
+
+    unrolled_list<int, 64> moved = std::move(list);
+    ASSERT_TRUE(moved.adaptive_capacity());
+    ASSERT_EQ(moved.capacity(), 64);
+    ASSERT_EQ(list.capacity(), 0);
+}
+
+TEST(AdaptiveCapacity, SnapshotOfSmallNodes) {
+    unrolled_list<std::string, 32, std::allocator<std::string>, true> list;
+    list.set_adaptive_capacity(true);
+    for (int i = 0; i != 10; ++i) {
+        list.push_back(std::to_string(i));
+    }
+    auto snapshot = list.snapshot();
+    list.front() = "changed";
+    list.insert(std::next(list.cbegin(), 3), "inserted");
+    ASSERT_EQ(snapshot.front(), "0");
+    ASSERT_EQ(snapshot.size(), 10);
+    ASSERT_EQ(list.size(), 11);
+    ASSERT_EQ(list.front(), "changed");
+    list.clear();
+    ASSERT_EQ(snapshot.back(), "9");
+}
+
+TEST(AdaptiveCapacity, SmallNodeMovesBetweenLists) {
+    unrolled_list<int, 64> source;
+    source.set_adaptive_capacity(true);
+    source.push_back(1);
+    source.push_back(2);
+
+    unrolled_list<int, 64> target = {10, 20, 30};
+    target.insert_node(std::next(target.cbegin()), source.extract_front_node());
+    ASSERT_THAT(target, ::testing::ElementsAre(10, 1, 2, 20, 30));
+    ASSERT_TRUE(source.empty());
+    ASSERT_EQ(target.capacity(), 64 + 4 + 64);
+
+    target.push_back(40);
+    target.insert(std::next(target.cbegin(), 2), 5);
+    target.insert(std::next(target.cbegin(), 2), 6);
+    target.insert(std::next(target.cbegin(), 2), 7);
+    ASSERT_THAT(target, ::testing::ElementsAre(10, 1, 7, 6, 5, 2, 20, 30, 40));
+}
+
+TEST(AdaptiveCapacity, SlabAllocator) {
+    unrolled_list<int, 16, slab_allocator<int>> list;
+    list.set_adaptive_capacity(true);
+    for (int i = 0; i != 300; ++i) {
+        list.push_front(i);
+    }
+    ASSERT_EQ(list.size(), 300);
+    ASSERT_EQ(list.front(), 299);
+    ASSERT_EQ(list.back(), 0);
+}
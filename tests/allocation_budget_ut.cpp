@@ -0,0 +1,183 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+/*
+    Регрессионные тесты на бюджет операций: для типовых сценариев (N push_back,
+    N push_front, копирование, clear, вставка диапазона, FIFO) число выделений
+    памяти, копирований и разрушений элементов не должно превышать границ,
+    выведенных из NodeMaxSize. Ухудшение split/insert/erase ломает эти тесты.
+*/
+
+namespace {
+
+struct Budget {
+    static inline size_t allocations = 0;
+    static inline size_t deallocations = 0;
+    static inline size_t copies = 0;
+    static inline size_t destructions = 0;
+
+    static void reset() { allocations = deallocations = copies = destructions = 0; }
+};
+
+class Counted {
+public:
+    Counted(int value) : value_(value) {}
+    Counted(const Counted& other) : value_(other.value_) { ++Budget::copies; }
+    Counted& operator=(const Counted&) = default;
+    ~Counted() { ++Budget::destructions; }
+
+    int value() const { return value_; }
+
+private:
+    int value_;
+};
+
+template<typename T>
+class BudgetAllocator {
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    BudgetAllocator() = default;
+    template<typename U>
+    BudgetAllocator(const BudgetAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        ++Budget::allocations;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t) {
+        ++Budget::deallocations;
+        ::operator delete(p);
+    }
+
+    bool operator==(const BudgetAllocator&) const { return true; }
+};
+
+constexpr size_t nodes_for(size_t elements, size_t node_size) { return (elements + node_size - 1) / node_size; }
+
+}  // namespace
+
+template<typename NodeSize>
+class AllocationBudget : public testing::Test {
+public:
+    static constexpr size_t M = NodeSize::value;
+    static constexpr size_t N = 1000;
+    using list_type = unrolled_list<Counted, M, BudgetAllocator<Counted>>;
+
+    static list_type filled(size_t n) {
+        list_type list;
+        for (size_t i = 0; i != n; ++i) {
+            list.push_back(static_cast<int>(i));
+        }
+        return list;
+    }
+};
+
+using NodeSizes = testing::Types<
+    std::integral_constant<size_t, 1>,
+    std::integral_constant<size_t, 5>,
+    std::integral_constant<size_t, 16>,
+    std::integral_constant<size_t, 64>
+>;
+TYPED_TEST_SUITE(AllocationBudget, NodeSizes);
+
+TYPED_TEST(AllocationBudget, PushBack) {
+    constexpr size_t M = TestFixture::M, N = TestFixture::N;
+    typename TestFixture::list_type list;
+    Counted value = 0;
+    Budget::reset();
+    for (size_t i = 0; i != N; ++i) {
+        list.push_back(value);
+    }
+    // appending never moves an element: one node per M elements, one copy per element
+    ASSERT_LE(Budget::allocations, nodes_for(N, M));
+    ASSERT_EQ(Budget::copies, N);
+    ASSERT_EQ(Budget::destructions, 0);
+    ASSERT_EQ(Budget::deallocations, 0);
+}
+
+TYPED_TEST(AllocationBudget, PushFront) {
+    constexpr size_t M = TestFixture::M, N = TestFixture::N;
+    typename TestFixture::list_type list;
+    Counted value = 0;
+    Budget::reset();
+    for (size_t i = 0; i != N; ++i) {
+        list.push_front(value);
+    }
+    // a node filled from the front shifts 0 + 1 + ... + (M - 1) elements, then one split moves all M
+    constexpr size_t moves_per_node = M * (M - 1) / 2 + M;
+    ASSERT_LE(Budget::allocations, nodes_for(N, M));
+    ASSERT_LE(Budget::copies, N + nodes_for(N, M) * moves_per_node);
+    ASSERT_EQ(Budget::copies - Budget::destructions, N);
+    ASSERT_EQ(Budget::deallocations, 0);
+}
+
+TYPED_TEST(AllocationBudget, CopyConstruction) {
+    constexpr size_t M = TestFixture::M, N = TestFixture::N;
+    auto source = TestFixture::filled(N);
+    Budget::reset();
+    typename TestFixture::list_type copy(source);
+    // the copy is packed into full nodes regardless of the source layout
+    ASSERT_EQ(Budget::allocations, nodes_for(N, M));
+    ASSERT_EQ(Budget::copies, N);
+    ASSERT_EQ(Budget::destructions, 0);
+}
+
+TYPED_TEST(AllocationBudget, Clear) {
+    constexpr size_t M = TestFixture::M, N = TestFixture::N;
+    auto list = TestFixture::filled(N);
+    Budget::reset();
+    list.clear();
+    ASSERT_EQ(Budget::allocations, 0);
+    ASSERT_EQ(Budget::deallocations, nodes_for(N, M));
+    ASSERT_EQ(Budget::copies, 0);
+    ASSERT_EQ(Budget::destructions, N);
+}
+
+TYPED_TEST(AllocationBudget, BulkInsert) {
+    constexpr size_t M = TestFixture::M, N = TestFixture::N;
+    auto list = TestFixture::filled(N);
+    std::vector<Counted> batch;
+    batch.reserve(N);
+    for (size_t i = 0; i != N; ++i) {
+        batch.emplace_back(static_cast<int>(i));
+    }
+    auto pos = list.begin();
+    for (size_t i = 0; i != N / 2 + M / 2; ++i) {
+        ++pos;
+    }
+
+    Budget::reset();
+    list.insert_range(pos, batch);
+    // at most one split of the target node on top of copying the batch into fresh nodes
+    ASSERT_LE(Budget::allocations, nodes_for(N, M) + 1);
+    ASSERT_LE(Budget::copies, N + M);
+    ASSERT_LE(Budget::destructions, M);
+    ASSERT_EQ(list.size(), 2 * N);
+}
+
+TYPED_TEST(AllocationBudget, FifoChurn) {
+    constexpr size_t M = TestFixture::M, N = TestFixture::N;
+    constexpr size_t queue_length = 100, rounds = 10 * N;
+    auto list = TestFixture::filled(queue_length);
+    Counted value = 0;
+
+    Budget::reset();
+    for (size_t i = 0; i != rounds; ++i) {
+        list.push_back(value);
+        list.pop_front();
+    }
+    // every M rounds a node is appended and one drained; popping shifts the rest of the front node,
+    // (M - 1) / 2 elements on average
+    ASSERT_LE(Budget::allocations, rounds / M + 1);
+    ASSERT_LE(Budget::deallocations, rounds / M + 1);
+    ASSERT_LE(Budget::copies, rounds + rounds * (M - 1) / 2 + M * M);
+    ASSERT_EQ(Budget::copies, Budget::destructions);  // the length of the queue does not change
+    ASSERT_EQ(list.size(), queue_length);
+    ASSERT_LE(list.capacity(), (nodes_for(queue_length, M) + 1) * M);
+}
@@ -58,7 +58,7 @@ public:
     }
 
     void deallocate(pointer p, std::size_t n) {
-        delete p;
+        delete[] reinterpret_cast<char*>(p);
     }
 
     bool operator==(const TestAllocator& other) const {
@@ -108,3 +108,45 @@ TEST_F(WorkWithAllocatorTest, simplePushBack) {
     ASSERT_EQ(SomeObj::ConstructorCalled, 11);
     ASSERT_EQ(SomeObj::DestructorCalled, 11);
 }
+
+/*
+    Пустой список не должен выделять память: ни при создании, ни при копировании, ни при перемещении.
+*/
+TEST_F(WorkWithAllocatorTest, emptyListDoesNotAllocate) {
+    unrolled_list<SomeObj, 5, TestAllocator<SomeObj>> list;
+    unrolled_list<SomeObj, 5, TestAllocator<SomeObj>> copy(list);
+    unrolled_list<SomeObj, 5, TestAllocator<SomeObj>> moved(std::move(list));
+    copy = moved;
+
+    ASSERT_TRUE(copy.empty());
+    ASSERT_EQ(TestAllocator<NodeTag>::AllocationCount, 0);
+    ASSERT_EQ(TestAllocator<SomeObj>::AllocationCount, 0);
+}
+
+/*
+    Перемещение (конструктор, присваивание, swap) передаёт ноды без аллокаций и без копирования элементов.
+*/
+TEST_F(WorkWithAllocatorTest, moveDoesNotAllocate) {
+    unrolled_list<int, 5, TestAllocator<int>> list = {1, 2, 3, 4, 5, 6, 7};
+    int allocations = TestAllocator<NodeTag>::AllocationCount;
+
+    unrolled_list<int, 5, TestAllocator<int>> moved(std::move(list));
+    ASSERT_TRUE(list.empty());
+    ASSERT_THAT(moved, ::testing::ElementsAre(1, 2, 3, 4, 5, 6, 7));
+
+    unrolled_list<int, 5, TestAllocator<int>> assigned;
+    assigned = std::move(moved);
+    ASSERT_TRUE(moved.empty());
+    ASSERT_THAT(assigned, ::testing::ElementsAre(1, 2, 3, 4, 5, 6, 7));
+
+    assigned.swap(list);
+    ASSERT_TRUE(assigned.empty());
+    ASSERT_THAT(list, ::testing::ElementsAre(1, 2, 3, 4, 5, 6, 7));
+
+    ASSERT_EQ(TestAllocator<NodeTag>::AllocationCount, allocations);
+
+    list.push_back(8);
+    moved.push_front(0);
+    ASSERT_THAT(list, ::testing::ElementsAre(1, 2, 3, 4, 5, 6, 7, 8));
+    ASSERT_THAT(moved, ::testing::ElementsAre(0));
+}
@@ -0,0 +1,128 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <compare>
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+    Тесты для operator== и operator<=>: списки сравниваются поблочно, поэтому
+    проверяем списки с одинаковыми элементами, но разным разбиением на узлы,
+    типы со сравнением через memcmp и без него, и лексикографический порядок
+    как у std::vector.
+*/
+
+namespace {
+
+template<typename T, size_t N>
+unrolled_list<T, N> Packed(const std::vector<T>& values) {
+    return unrolled_list<T, N>(values.begin(), values.end());
+}
+
+template<typename T, size_t N>
+unrolled_list<T, N> Uneven(const std::vector<T>& values) {
+    unrolled_list<T, N> list;
+    for (auto iter = values.rbegin(); iter != values.rend(); ++iter) {
+        list.push_front(*iter);
+    }
+    return list;
+}
+
+struct OnlyLess {
+    int key;
+    int payload;  // ignored by the ordering
+    bool operator<(const OnlyLess& other) const { return key < other.key; }
+    bool operator==(const OnlyLess& other) const { return key == other.key; }
+};
+
+struct Key {
+    int id;
+    int hits;  // ignored by the comparison
+    bool operator==(const Key& other) const { return id == other.id; }
+    auto operator<=>(const Key& other) const { return id <=> other.id; }
+};
+
+}  // namespace
+
+TEST(Comparison, EqualAcrossNodeLayouts) {
+    std::vector<int> values;
+    for (int i = 0; i != 100; ++i) { values.push_back(i * 7 % 13); }
+    auto packed = Packed<int, 8>(values);
+    auto uneven = Uneven<int, 8>(values);
+    ASSERT_TRUE(packed == uneven);
+    ASSERT_EQ(packed <=> uneven, std::strong_ordering::equal);
+
+    *(uneven.begin() + 99) = -1;
+    ASSERT_FALSE(packed == uneven);
+    ASSERT_TRUE(packed != uneven);
+    ASSERT_EQ(packed <=> uneven, std::strong_ordering::greater);
+}
+
+TEST(Comparison, LexicographicLikeVector) {
+    std::vector<std::vector<int>> samples = {
+        {}, {1}, {1, 2}, {1, 2, 3}, {1, 3}, {2}, {0, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5},
+        {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 13},
+    };
+    for (const auto& a : samples) {
+        for (const auto& b : samples) {
+            auto lhs = Packed<int, 5>(a);
+            auto rhs = Uneven<int, 5>(b);
+            ASSERT_EQ(lhs <=> rhs, a <=> b);
+            ASSERT_EQ(lhs == rhs, a == b);
+            ASSERT_EQ(lhs < rhs, a < b);
+        }
+    }
+}
+
+TEST(Comparison, FloatingPointUsesValueEquality) {
+    unrolled_list<double, 4> zeros = {0.0, 1.0, 2.0};
+    unrolled_list<double, 4> negative_zeros = {-0.0, 1.0, 2.0};
+    ASSERT_TRUE(zeros == negative_zeros);  // different bytes, equal values
+
+    unrolled_list<double, 4> nans = {std::nan(""), 1.0};
+    ASSERT_FALSE(nans == nans);
+    ASSERT_EQ(nans <=> nans, std::partial_ordering::unordered);
+}
+
+TEST(Comparison, Strings) {
+    unrolled_list<std::string, 3> lhs = {"a", "b", "c", "d"};
+    unrolled_list<std::string, 3> rhs = {"a", "b", "c", "e"};
+    ASSERT_LT(lhs, rhs);
+    ASSERT_GT(rhs, lhs);
+    ASSERT_EQ(lhs <=> lhs, std::strong_ordering::equal);
+}
+
+TEST(Comparison, OnlyOperatorLess) {
+    unrolled_list<OnlyLess, 2> lhs = {{1, 100}, {2, 200}, {3, 300}};
+    unrolled_list<OnlyLess, 2> rhs = {{1, 0}, {2, 0}, {4, 0}};
+    static_assert(std::is_same_v<decltype(lhs <=> rhs), std::weak_ordering>);
+    ASSERT_EQ(lhs <=> rhs, std::weak_ordering::less);
+}
+
+TEST(Comparison, UserDefinedEqualityIgnoresBytes) {
+    static_assert(std::has_unique_object_representations_v<Key>);
+    unrolled_list<Key, 4> lhs = {{1, 0}};
+    unrolled_list<Key, 4> rhs = {{1, 5}};
+    ASSERT_TRUE(lhs == rhs);
+    ASSERT_EQ(lhs <=> rhs, std::strong_ordering::equal);
+
+    unrolled_list<Key, 4> longer = {{1, 7}, {2, 0}};
+    ASSERT_EQ(lhs <=> longer, std::strong_ordering::less);
+    ASSERT_NE(lhs, longer);
+}
+
+TEST(Comparison, MapKeys) {
+    std::map<unrolled_list<int, 4>, std::string> map;
+    map[{3, 1}] = "c";
+    map[{1, 2, 3, 4, 5}] = "a";
+    map[{1, 2, 3, 4, 5, 6}] = "b";
+    map[{}] = "empty";
+    std::vector<std::string> order;
+    for (const auto& [key, value] : map) { order.push_back(value); }
+    ASSERT_EQ(order, (std::vector<std::string>{"empty", "a", "b", "c"}));
+    ASSERT_EQ(map.at({1, 2, 3, 4, 5}), "a");
+}
@@ -0,0 +1,87 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <list>
+#include <stdexcept>
+
+/*
+    Тесты для cursor: позиционный доступ, вставка и удаление по позиции
+    сравниваются с тем же набором операций над std::list.
+*/
+
+namespace {
+
+std::list<int>::iterator std_at(std::list<int>& list, size_t pos) {
+    auto iter = list.begin();
+    std::advance(iter, pos);
+    return iter;
+}
+
+}  // namespace
+
+TEST(Cursor, SequentialAccess) {
+    unrolled_list<int, 4> list;
+    for (int i = 0; i != 100; ++i) {
+        list.push_back(i);
+    }
+    auto cursor = list.make_cursor();
+    for (int i = 0; i < 100; i += 3) {
+        ASSERT_EQ(*cursor.at(i), i);
+    }
+    for (int i = 99; i >= 0; i -= 7) {
+        ASSERT_EQ(*cursor.at(i), i);
+    }
+    ASSERT_EQ(cursor.at(100), list.end());
+}
+
+TEST(Cursor, RememberedNode) {
+    unrolled_list<int, 4> list;
+    for (int i = 0; i != 20; ++i) {
+        list.push_back(i);
+    }
+    auto cursor = list.make_cursor();
+    cursor.at(9);
+    ASSERT_EQ(cursor.position(), 8);
+}
+
+TEST(Cursor, InsertAndErase) {
+    std::list<int> std_list;
+    unrolled_list<int, 5> unrolled_list;
+    auto cursor = unrolled_list.make_cursor();
+
+    size_t pos = 0;
+    for (int i = 0; i != 1000; ++i) {
+        if (i % 4 == 3 && !std_list.empty()) {
+            pos %= std_list.size();
+            std_list.erase(std_at(std_list, pos));
+            cursor.erase(pos);
+        } else {
+            pos %= std_list.size() + 1;
+            std_list.insert(std_at(std_list, pos), i);
+            ASSERT_EQ(*cursor.insert(pos, i), i);
+        }
+        pos += i % 3;
+    }
+
+    ASSERT_THAT(unrolled_list, ::testing::ElementsAreArray(std_list));
+}
+
+TEST(Cursor, EraseEverything) {
+    unrolled_list<int, 3> list = {1, 2, 3, 4, 5, 6, 7};
+    auto cursor = list.make_cursor();
+    while (!list.empty()) {
+        cursor.erase(list.size() / 2);
+    }
+    ASSERT_EQ(cursor.at(0), list.end());
+    cursor.insert(0, 42);
+    ASSERT_THAT(list, ::testing::ElementsAre(42));
+}
+
+TEST(Cursor, OutOfRange) {
+    unrolled_list<int, 3> list = {1, 2};
+    auto cursor = list.make_cursor();
+    ASSERT_THROW(cursor.at(3), std::out_of_range);
+    ASSERT_THROW(cursor.erase(2), std::out_of_range);
+}
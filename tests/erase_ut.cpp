@@ -3,6 +3,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
+#include <vector>
+
 TEST(Erases, EraseAllListOneNode) {
     unrolled_list<int, 5> list = {1, 2, 3, 4, 5};
     for (auto iter = list.begin(); iter != list.end();) {
@@ -55,3 +58,83 @@ TEST(Erases, ReUseContainer) {
     list.push_back(1);
     ASSERT_EQ(*list.begin(), 1);
 }
+
+/*
+    Удаление диапазона: сравнение с std::vector для всех пар границ
+    на списке с неравномерно заполненными узлами, плюс проверка того,
+    что внутренние узлы освобождаются целиком, без сдвигов элементов.
+*/
+
+namespace {
+
+unrolled_list<int, 4> UnevenList(int n) {
+    unrolled_list<int, 4> list;
+    for (int i = n - 1; i >= 0; --i) {
+        list.push_front(i);
+    }
+    return list;
+}
+
+struct CopyCounted {
+    static inline int copies = 0;
+    static inline int alive = 0;
+
+    CopyCounted(int v) : value(v) { ++alive; }
+    CopyCounted(const CopyCounted& other) : value(other.value) { ++copies; ++alive; }
+    ~CopyCounted() { --alive; }
+
+    int value;
+};
+
+}  // namespace
+
+TEST(Erases, EraseRangeMatchesVector) {
+    const int n = 23;
+    for (int from = 0; from <= n; ++from) {
+        for (int to = from; to <= n; ++to) {
+            auto list = UnevenList(n);
+            std::vector<int> expected(list.begin(), list.end());
+            auto first = list.cbegin();
+            for (int i = 0; i != from; ++i) { ++first; }
+            auto last = first;
+            for (int i = from; i != to; ++i) { ++last; }
+
+            auto iter = list.erase(first, last);
+            expected.erase(expected.begin() + from, expected.begin() + to);
+
+            ASSERT_EQ(std::vector<int>(list.begin(), list.end()), expected) << from << ' ' << to;
+            ASSERT_EQ(list.size(), expected.size());
+            if (to == n) {
+                ASSERT_EQ(iter, list.end());
+            } else {
+                ASSERT_EQ(*iter, expected[from]);
+            }
+            std::vector<int> backwards(list.rbegin(), list.rend());
+            ASSERT_TRUE(std::equal(backwards.begin(), backwards.end(), expected.rbegin()));
+        }
+    }
+}
+
+TEST(Erases, EraseWholeList) {
+    unrolled_list<int, 3> list = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    ASSERT_EQ(list.erase(list.begin(), list.end()), list.end());
+    ASSERT_TRUE(list.empty());
+    list.push_back(1);
+    ASSERT_EQ(list.front(), 1);
+}
+
+TEST(Erases, EraseRangeFreesInteriorNodesWithoutShifting) {
+    CopyCounted::alive = 0;
+    unrolled_list<CopyCounted, 10> list;
+    for (int i = 0; i != 1000; ++i) { list.push_back(i); }
+
+    CopyCounted::copies = 0;
+    auto first = list.cbegin() + 5;
+    auto last = list.cbegin() + 995;
+    auto iter = list.erase(first, last);
+    ASSERT_LE(CopyCounted::copies, 10);  // only the survivors of the last node move
+    ASSERT_EQ(CopyCounted::alive, 10);
+    ASSERT_EQ(iter->value, 995);
+    ASSERT_EQ(list.size(), 10);
+    ASSERT_EQ(list.capacity(), 20);
+}
@@ -3,7 +3,10 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
 #include <list>
+#include <string>
+#include <vector>
 
 class NodeTag {};
 
@@ -46,6 +49,32 @@ struct BadOrGood {
     std::string Name;
 };
 
+/// copy constructor or assignment throws on the copies_left-th copy from now (never while copies_left is 0)
+struct ThrowingString {
+    static inline int copies_left = 0;
+    static inline int alive = 0;
+
+    ThrowingString(const char* v) : value(v) { ++alive; }
+    ThrowingString(const ThrowingString& other) : value(other.value) {
+        if (copies_left > 0 && --copies_left == 0) {
+            throw std::runtime_error("");
+        }
+        ++alive;
+    }
+    ThrowingString& operator=(const ThrowingString& other) {
+        if (copies_left > 0 && --copies_left == 0) {
+            throw std::runtime_error("");
+        }
+        value = other.value;
+        return *this;
+    }
+    ~ThrowingString() { --alive; }
+
+    auto operator<=>(const ThrowingString&) const = default;
+
+    std::string value;
+};
+
 template<typename T>
 class TestAllocator {
 public:
@@ -185,3 +214,161 @@ TEST_F(ExceptionSafetyTest, failesAtPushBack) {
     ASSERT_EQ(unrolled_list.begin()->Name, std::string("first"));
     ASSERT_EQ((++unrolled_list.begin())->Name, std::string("second"));
 }
+
+/*
+    Вставка диапазона в середину полного узла: сначала строится цепочка новых узлов,
+    затем узел разбивается (split), и хвост копируется в новый узел.
+    Копирование хвоста выбрасывает исключение на втором элементе.
+
+    Тест проверяет:
+        1. insert_range выбросит исключение
+        2. Список не изменится (строгая гарантия), итерирование по нему безопасно
+        3. Все созданные копии будут уничтожены
+*/
+TEST_F(ExceptionSafetyTest, failesAtSplitDuringInsertRange) {
+    {
+        // long enough to live on the heap, so a destroyed element cannot be read back by accident
+        const char* a = "first element, too long for the small string buffer";
+        const char* b = "second element, too long for the small string buffer";
+        const char* c = "third element, too long for the small string buffer";
+        const char* d = "fourth element, too long for the small string buffer";
+        unrolled_list<ThrowingString, 4> list = {a, b, c, d};
+        std::vector<ThrowingString> values = {"1", "2", "3", "4", "5"};
+        int alive = ThrowingString::alive;
+
+        ThrowingString::copies_left = 5 + 2;  // the chain of five, then the second element moved by split
+        ASSERT_ANY_THROW(list.insert_range(++list.cbegin(), values));
+        ThrowingString::copies_left = 0;
+
+        ASSERT_EQ(ThrowingString::alive, alive);
+        ASSERT_EQ(list.size(), 4);
+        ASSERT_THAT(list, testing::ElementsAre(a, b, c, d));
+
+        list.insert_range(++list.cbegin(), values);
+        ASSERT_THAT(list, testing::ElementsAre(a, "1", "2", "3", "4", "5", b, c, d));
+    }
+    ASSERT_EQ(ThrowingString::alive, 0);
+}
+
+/*
+    push_back в полный последний узел: split создаёт новый пустой узел,
+    а копирование нового элемента в него выбрасывает исключение.
+
+    Тест проверяет:
+        1. push_back выбросит исключение
+        2. Пустой узел не останется в списке: итерирование и min_element работают,
+           вместимость не изменится
+*/
+TEST_F(ExceptionSafetyTest, failesAtPushBackIntoFullNode) {
+    {
+        unrolled_list<ThrowingString, 4> list = {"d", "b", "c", "e"};
+        ThrowingString value = "a";
+        size_t capacity = list.capacity();
+
+        ThrowingString::copies_left = 1;
+        ASSERT_ANY_THROW(list.push_back(value));
+        ThrowingString::copies_left = 0;
+
+        ASSERT_EQ(list.size(), 4);
+        ASSERT_EQ(list.capacity(), capacity);
+        ASSERT_THAT(list, testing::ElementsAre("d", "b", "c", "e"));
+        ASSERT_EQ(std::min_element(list.begin(), list.end())->value, "b");
+        ASSERT_EQ(list.back().value, "e");
+
+        list.push_back(value);
+        ASSERT_THAT(list, testing::ElementsAre("d", "b", "c", "e", "a"));
+        ASSERT_EQ(std::min_element(list.begin(), list.end())->value, "a");
+    }
+    ASSERT_EQ(ThrowingString::alive, 0);
+}
+
+/*
+    push_front в полный первый узел (и любая вставка при NodeMaxSize = 1):
+    исключение выбрасывает одно из копирований, каждое по очереди.
+
+    Тест проверяет:
+        1. Если push_front выбросил исключение, в списке не осталось пустого узла:
+           обход от cbegin() до cend() проходит все элементы, вместимость не изменилась
+        2. Все созданные копии будут уничтожены
+*/
+TEST_F(ExceptionSafetyTest, failesAtPushFrontOntoFullNode) {
+    {
+        unrolled_list<ThrowingString, 4> list = {"a", "b", "c", "d"};
+        ThrowingString value = "x";
+        size_t capacity = list.capacity();
+        for (int copy = 1; copy <= 6; ++copy) {
+            ThrowingString::copies_left = copy;
+            try {
+                list.push_front(value);
+                ThrowingString::copies_left = 0;
+                list.pop_front();
+                continue;
+            } catch (const std::runtime_error&) {
+                ThrowingString::copies_left = 0;
+            }
+            ASSERT_EQ(list.size(), 4);
+            ASSERT_EQ(list.capacity(), capacity);
+            std::vector<std::string> walked;
+            for (auto iter = list.cbegin(); iter != list.cend(); ++iter) {
+                walked.push_back(iter->value);
+            }
+            ASSERT_THAT(walked, testing::ElementsAre("a", "b", "c", "d"));
+        }
+        list.push_front(value);
+        ASSERT_THAT(list, testing::ElementsAre("x", "a", "b", "c", "d"));
+    }
+    {
+        unrolled_list<ThrowingString, 1> list = {"a", "b"};
+        ThrowingString value = "x";
+        for (std::ptrdiff_t pos : {0, 1, 2}) {
+            ThrowingString::copies_left = 1;
+            ASSERT_ANY_THROW(list.insert(std::next(list.cbegin(), pos), value));
+            ThrowingString::copies_left = 0;
+            ASSERT_THAT(list, testing::ElementsAre("a", "b"));
+            ASSERT_EQ(std::distance(list.cbegin(), list.cend()), 2);
+        }
+    }
+    ASSERT_EQ(ThrowingString::alive, 0);
+}
+
+/*
+    Удаление первого элемента узла: оставшиеся элементы сдвигаются присваиванием,
+    и одно из присваиваний выбрасывает исключение. Строки длинные, поэтому
+    чтение уничтоженного элемента заметит AddressSanitizer.
+
+    Тест проверяет:
+        1. erase выбросит исключение
+        2. Базовая гарантия: ни один элемент не уничтожен, размер не изменился,
+           все элементы можно прочитать
+        3. Все созданные копии будут уничтожены
+*/
+TEST_F(ExceptionSafetyTest, failesAtShiftDuringErase) {
+    {
+        std::vector<std::string> values;
+        for (int i = 0; i != 6; ++i) {
+            values.push_back(std::to_string(i) + " is too long for the small string buffer");
+        }
+        unrolled_list<ThrowingString, 8> list;
+        for (const std::string& value : values) {
+            list.push_back(value.c_str());
+        }
+        int alive = ThrowingString::alive;
+
+        ThrowingString::copies_left = 3;
+        ASSERT_ANY_THROW(list.erase(list.cbegin()));
+        ThrowingString::copies_left = 0;
+
+        ASSERT_EQ(list.size(), 6);
+        ASSERT_EQ(ThrowingString::alive, alive);
+        size_t total = 0;
+        for (const ThrowingString& element : list) {
+            total += element.value.size();
+        }
+        ASSERT_GT(total, 0);
+        ASSERT_EQ(list.back().value, values.back());
+
+        list.erase(list.cbegin());
+        ASSERT_EQ(list.size(), 5);
+    }
+    ASSERT_EQ(ThrowingString::alive, 0);
+}
@@ -1,4 +1,5 @@
 #include <stdexcept>
+#include <vector>
 #include <unrolled_list.h>
 
 #include <gtest/gtest.h>
@@ -73,3 +74,107 @@ TEST(ReverseIterators, DecrementRBeginThrow) {
     unrolled_list<char> list{1};
     ASSERT_THROW(--list.rbegin(), std::out_of_range);
 }
+
+/*
+    Прыжки итератора через целые узлы: +=, -=, +, -, разность итераторов
+    и advance/distance, найденные через ADL. Узлы заполнены неравномерно.
+*/
+
+namespace {
+
+unrolled_list<int, 5> UnevenList(int n) {
+    unrolled_list<int, 5> list;
+    for (int i = n - 1; i >= 0; --i) {
+        list.push_front(i);
+    }
+    // the erasures leave partly filled nodes
+    for (auto iter = list.begin(); iter != list.end();) {
+        if (*iter % 7 == 3) { iter = list.erase(iter); } else { ++iter; }
+    }
+    return list;
+}
+
+}  // namespace
+
+TEST(IteratorJumps, PlusEqualsMatchesIncrements) {
+    auto list = UnevenList(200);
+    std::vector<int> expected(list.begin(), list.end());
+    for (size_t k = 0; k <= expected.size(); ++k) {
+        auto iter = list.begin();
+        iter += static_cast<std::ptrdiff_t>(k);
+        if (k == expected.size()) {
+            ASSERT_EQ(iter, list.end());
+        } else {
+            ASSERT_EQ(*iter, expected[k]);
+        }
+    }
+}
+
+TEST(IteratorJumps, MinusEqualsMatchesDecrements) {
+    auto list = UnevenList(200);
+    std::vector<int> expected(list.begin(), list.end());
+    for (size_t k = 1; k <= expected.size(); ++k) {
+        auto iter = list.end();
+        iter -= static_cast<std::ptrdiff_t>(k);
+        ASSERT_EQ(*iter, expected[expected.size() - k]);
+    }
+    ASSERT_EQ(list.end() - static_cast<std::ptrdiff_t>(expected.size()), list.begin());
+}
+
+TEST(IteratorJumps, NegativeAndMixedJumps) {
+    auto list = UnevenList(100);
+    std::vector<int> expected(list.begin(), list.end());
+    auto iter = list.begin() + 40;
+    ASSERT_EQ(*iter, expected[40]);
+    iter += -17;
+    ASSERT_EQ(*iter, expected[23]);
+    iter -= -30;
+    ASSERT_EQ(*iter, expected[53]);
+    ASSERT_EQ(*(3 + iter), expected[56]);
+    ASSERT_EQ(*(iter - 53), expected[0]);
+}
+
+TEST(IteratorJumps, OutOfRangeThrows) {
+    unrolled_list<int, 4> list = {1, 2, 3, 4, 5, 6};
+    ASSERT_THROW(list.begin() + 7, std::out_of_range);
+    ASSERT_THROW(list.end() - 7, std::out_of_range);
+    ASSERT_NO_THROW(list.begin() + 6);
+    ASSERT_NO_THROW(list.end() - 6);
+
+    unrolled_list<int, 4> empty;
+    ASSERT_EQ(empty.begin() + 0, empty.end());
+    ASSERT_THROW(empty.begin() + 1, std::out_of_range);
+    ASSERT_THROW(empty.end() - 1, std::out_of_range);
+}
+
+TEST(IteratorJumps, Difference) {
+    auto list = UnevenList(150);
+    auto size = static_cast<std::ptrdiff_t>(list.size());
+    ASSERT_EQ(list.end() - list.begin(), size);
+    ASSERT_EQ(list.begin() - list.end(), -size);
+    ASSERT_EQ(list.end() - list.end(), 0);
+    for (std::ptrdiff_t a = 0; a < size; a += 11) {
+        for (std::ptrdiff_t b = 0; b < size; b += 13) {
+            ASSERT_EQ((list.begin() + a) - (list.begin() + b), a - b);
+        }
+    }
+    unrolled_list<int, 5>::const_iterator citer = list.cbegin() + 9;
+    ASSERT_EQ(citer - list.cbegin(), 9);
+
+    unrolled_list<int, 4> empty;
+    ASSERT_EQ(empty.end() - empty.begin(), 0);
+}
+
+TEST(IteratorJumps, AdvanceAndDistanceThroughAdl) {
+    auto list = UnevenList(120);
+    std::vector<int> expected(list.begin(), list.end());
+    auto iter = list.begin();
+    using std::advance;
+    using std::distance;
+    advance(iter, 77);
+    ASSERT_EQ(*iter, expected[77]);
+    advance(iter, -50);
+    ASSERT_EQ(*iter, expected[27]);
+    ASSERT_EQ(distance(list.begin(), iter), 27);
+    ASSERT_EQ(distance(list.begin(), list.end()), static_cast<std::ptrdiff_t>(expected.size()));
+}
@@ -0,0 +1,121 @@
+#include <unrolled_list.h>
+#include <slab_allocator.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <stdexcept>
+#include <vector>
+
+/*
+    Тесты для extract_front_node / extract_node / insert_node: узел переходит
+    из списка в список вместе с элементами, без копирования элементов.
+*/
+
+namespace {
+
+struct CopyCounted {
+    static inline int copies = 0;
+    static inline int alive = 0;
+
+    CopyCounted(int v) : value(v) { ++alive; }
+    CopyCounted(const CopyCounted& other) : value(other.value) { ++copies; ++alive; }
+    ~CopyCounted() { --alive; }
+
+    int value;
+};
+
+template<typename List>
+std::vector<int> Values(const List& list) {
+    std::vector<int> result;
+    for (const auto& element : list) { result.push_back(element.value); }
+    return result;
+}
+
+}  // namespace
+
+TEST(NodeHandle, ExtractFrontNodeMovesWholeBatch) {
+    unrolled_list<CopyCounted, 4> source;
+    for (int i = 0; i != 10; ++i) { source.push_back(i); }
+    unrolled_list<CopyCounted, 4> target;
+
+    CopyCounted::copies = 0;
+    auto handle = source.extract_front_node();
+    ASSERT_FALSE(handle.empty());
+    ASSERT_EQ(handle.size(), 4);
+    ASSERT_EQ(handle.elements()[0].value, 0);
+    ASSERT_EQ(source.size(), 6);
+    ASSERT_EQ(source.front().value, 4);
+
+    auto iter = target.insert_node(target.end(), std::move(handle));
+    ASSERT_TRUE(handle.empty());
+    ASSERT_EQ(iter->value, 0);
+    ASSERT_EQ(CopyCounted::copies, 0);
+    ASSERT_EQ(Values(target), (std::vector<int>{0, 1, 2, 3}));
+
+    target.insert_node(target.end(), source.extract_front_node());
+    target.insert_node(target.begin(), source.extract_front_node());
+    ASSERT_EQ(CopyCounted::copies, 0);
+    ASSERT_EQ(Values(target), (std::vector<int>{8, 9, 0, 1, 2, 3, 4, 5, 6, 7}));
+    ASSERT_TRUE(source.empty());
+    ASSERT_EQ(target.size(), 10);
+    ASSERT_TRUE(source.extract_front_node().empty());
+}
+
+TEST(NodeHandle, ExtractNodeInTheMiddle) {
+    unrolled_list<CopyCounted, 3> list;
+    for (int i = 0; i != 9; ++i) { list.push_back(i); }
+    auto pos = list.begin();
+    ++pos; ++pos; ++pos; ++pos;  // element 4, in the middle node
+
+    auto handle = list.extract_node(pos);
+    ASSERT_EQ(handle.size(), 3);
+    ASSERT_EQ(Values(list), (std::vector<int>{0, 1, 2, 6, 7, 8}));
+    ASSERT_TRUE(list.extract_node(list.end()).empty());
+
+    // back in the middle of a node: the node is split at the insertion point
+    pos = list.begin();
+    ++pos;
+    auto iter = list.insert_node(pos, std::move(handle));
+    ASSERT_EQ(iter->value, 3);
+    ASSERT_EQ(Values(list), (std::vector<int>{0, 3, 4, 5, 1, 2, 6, 7, 8}));
+    ASSERT_EQ(list.size(), 9);
+
+    std::vector<int> backwards;
+    for (auto it = list.rbegin(); it != list.rend(); ++it) { backwards.push_back(it->value); }
+    ASSERT_EQ(backwards, (std::vector<int>{8, 7, 6, 2, 1, 5, 4, 3, 0}));
+}
+
+TEST(NodeHandle, DroppedHandleDestroysElements) {
+    CopyCounted::alive = 0;
+    {
+        unrolled_list<CopyCounted, 4> list;
+        for (int i = 0; i != 6; ++i) { list.push_back(i); }
+        auto handle = list.extract_front_node();
+        ASSERT_EQ(CopyCounted::alive, 6);
+        auto other = std::move(handle);
+        ASSERT_EQ(other.size(), 4);
+    }
+    ASSERT_EQ(CopyCounted::alive, 0);
+}
+
+TEST(NodeHandle, EmptyHandleInsertIsNoOp) {
+    unrolled_list<int, 4> list = {1, 2, 3};
+    auto iter = list.insert_node(list.begin(), {});
+    ASSERT_EQ(*iter, 1);
+    ASSERT_EQ(list.size(), 3);
+}
+
+TEST(NodeHandle, IncompatibleAllocatorThrows) {
+    using list_type = unrolled_list<int, 4, slab_allocator<int>>;
+    list_type source = {1, 2, 3, 4, 5};
+    list_type target = {7};  // its own slab pool
+
+    auto handle = source.extract_front_node();
+    ASSERT_THROW(target.insert_node(target.end(), std::move(handle)), std::invalid_argument);
+    ASSERT_FALSE(handle.empty());
+    ASSERT_EQ(target.size(), 1);
+
+    source.insert_node(source.end(), std::move(handle));
+    ASSERT_THAT(source, testing::ElementsAre(5, 1, 2, 3, 4));
+}
@@ -0,0 +1,60 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+
+/*
+    Тесты на размер заголовка узла: кроме элементов узел хранит только два указателя
+    и счётчик минимальной ширины, поэтому накладные расходы не превышают трёх слов.
+    Списки со снимками (Snapshots = true) добавляют 32-битный счётчик ссылок.
+    Точные значения проверяются для 64-битных платформ.
+*/
+
+TEST(NodeLayout, OverheadFitsInThreeWords) {
+    ASSERT_LE((unrolled_list<char, 10>::node_overhead), 3 * sizeof(void*));
+    ASSERT_LE((unrolled_list<int, 16>::node_overhead), 3 * sizeof(void*));
+    ASSERT_LE((unrolled_list<double, 10>::node_overhead), 3 * sizeof(void*));
+    ASSERT_LE((unrolled_list<int, 1000>::node_overhead), 3 * sizeof(void*));
+}
+
+TEST(NodeLayout, OverheadOn64Bit) {
+    if (sizeof(void*) != 8) {
+        GTEST_SKIP() << "overhead values are measured for 64-bit pointers";
+    }
+    ASSERT_EQ((unrolled_list<char, 10>::node_overhead), 22);
+    ASSERT_EQ((unrolled_list<char, 64>::node_overhead), 24);
+    ASSERT_EQ((unrolled_list<int, 10>::node_overhead), 24);
+    ASSERT_EQ((unrolled_list<int, 16>::node_overhead), 24);
+    ASSERT_EQ((unrolled_list<int, 1000>::node_overhead), 24);
+    ASSERT_EQ((unrolled_list<uint16_t, 32>::node_overhead), 24);
+    ASSERT_EQ((unrolled_list<double, 10>::node_overhead), 24);
+}
+
+TEST(NodeLayout, ReferenceCountOnlyWithSnapshots) {
+    if (sizeof(void*) != 8) {
+        GTEST_SKIP() << "overhead values are measured for 64-bit pointers";
+    }
+    // the count takes the padding after the narrow counters, except where elements used it
+    ASSERT_EQ((unrolled_list<char, 10, std::allocator<char>, true>::node_overhead), 30);
+    ASSERT_EQ((unrolled_list<char, 64, std::allocator<char>, true>::node_overhead), 24);
+    ASSERT_EQ((unrolled_list<int, 16, std::allocator<int>, true>::node_overhead), 24);
+    ASSERT_EQ((unrolled_list<double, 10, std::allocator<double>, true>::node_overhead), 24);
+}
+
+TEST(NodeLayout, WideCounter) {
+    unrolled_list<char, 300> list;
+    for (int i = 0; i != 1000; ++i) {
+        list.push_back(static_cast<char>(i));
+    }
+    ASSERT_EQ(list.size(), 1000);
+    int i = 0;
+    for (char c : list) {
+        ASSERT_EQ(c, static_cast<char>(i++));
+    }
+    for (int j = 0; j != 700; ++j) {
+        list.pop_front();
+    }
+    ASSERT_EQ(list.front(), static_cast<char>(700));
+}
@@ -0,0 +1,172 @@
+#include <unrolled_list.h>
+#include <slab_allocator.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+    Тесты для параллельного конструктора unrolled_list(parallel_build, first, last)
+    и для splice(): параллельная сборка должна давать те же узлы, что и последовательная,
+    исключение из любого потока пробрасывается без утечек, а splice переносит узлы
+    другого списка без копирования элементов.
+*/
+
+namespace {
+
+template<typename List>
+std::vector<size_t> node_sizes(const List& list) {
+    std::vector<size_t> result;
+    for (auto block : list.nodes()) {
+        result.push_back(block.size());
+    }
+    return result;
+}
+
+std::vector<int> iota_vector(size_t n) {
+    std::vector<int> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+}
+
+struct ThrowingCopy {
+    static inline std::atomic<int> alive = 0;
+
+    explicit ThrowingCopy(int v) : value(v) { ++alive; }
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (value == throw_on) { throw std::runtime_error("copy failed"); }
+        ++alive;
+    }
+    ~ThrowingCopy() { --alive; }
+
+    static constexpr int throw_on = 90000;
+    int value;
+};
+
+}  // namespace
+
+TEST(ParallelBuild, SameNodesAsSerialBuild) {
+    std::vector<int> values = iota_vector(100003);
+    unrolled_list<int, 10> serial(values.begin(), values.end());
+    unrolled_list<int, 10> parallel(parallel_build, values.begin(), values.end());
+
+    ASSERT_EQ(parallel.size(), values.size());
+    ASSERT_TRUE(std::ranges::equal(parallel, values));
+    ASSERT_EQ(node_sizes(parallel), node_sizes(serial));
+    ASSERT_EQ(parallel.capacity(), serial.capacity());
+    ASSERT_EQ(parallel.stats().node_allocations, serial.stats().node_allocations);
+}
+
+TEST(ParallelBuild, LargeNodes) {
+    std::vector<int> values = iota_vector(70000);
+    unrolled_list<int, 64> parallel(parallel_build, values.begin(), values.end());
+    unrolled_list<int, 64> serial(values.begin(), values.end());
+    ASSERT_EQ(parallel, serial);
+    ASSERT_EQ(node_sizes(parallel), node_sizes(serial));
+}
+
+TEST(ParallelBuild, SmallInputs) {
+    for (size_t n : {0, 1, 9, 10, 11, 1000}) {
+        std::vector<int> values = iota_vector(n);
+        unrolled_list<int, 10> list(parallel_build, values.begin(), values.end());
+        ASSERT_EQ(list.size(), n);
+        ASSERT_TRUE(std::ranges::equal(list, values));
+    }
+}
+
+TEST(ParallelBuild, NonTrivialElements) {
+    std::vector<std::string> values;
+    for (int i = 0; i != 80000; ++i) {
+        values.push_back(std::to_string(i) + " is long enough to live on the heap");
+    }
+    unrolled_list<std::string, 16> list(parallel_build, values.begin(), values.end());
+    ASSERT_TRUE(std::ranges::equal(list, values));
+}
+
+TEST(ParallelBuild, ExceptionFromWorkerThread) {
+    {
+        std::vector<ThrowingCopy> values;
+        values.reserve(100000);
+        for (int i = 0; i != 100000; ++i) {
+            values.emplace_back(i);
+        }
+        int before = ThrowingCopy::alive;
+        using List = unrolled_list<ThrowingCopy, 16>;
+        ASSERT_THROW(List(parallel_build, values.begin(), values.end()), std::runtime_error);
+        ASSERT_EQ(ThrowingCopy::alive, before);
+    }
+    ASSERT_EQ(ThrowingCopy::alive, 0);
+}
+
+TEST(ParallelBuild, StatefulAllocatorBuildsSerially) {
+    std::vector<int> values = iota_vector(100000);
+    unrolled_list<int, 16, slab_allocator<int>> list(parallel_build, values.begin(), values.end());
+    ASSERT_TRUE(std::ranges::equal(list, values));
+}
+
+TEST(Splice, AtEndAndFront) {
+    unrolled_list<int, 4> list = {1, 2, 3};
+    unrolled_list<int, 4> tail = {4, 5, 6, 7, 8};
+    auto iter = list.splice(list.cend(), std::move(tail));
+    ASSERT_EQ(*iter, 4);
+    ASSERT_TRUE(tail.empty());
+    ASSERT_EQ(tail.capacity(), 0);
+
+    unrolled_list<int, 4> head = {-1, 0};
+    iter = list.splice(list.cbegin(), std::move(head));
+    ASSERT_EQ(iter, list.begin());
+    ASSERT_THAT(list, ::testing::ElementsAre(-1, 0, 1, 2, 3, 4, 5, 6, 7, 8));
+    ASSERT_EQ(list.size(), 10);
+    ASSERT_EQ(list.capacity(), 16);
+
+    list.push_back(9);
+    tail.push_back(10);
+    ASSERT_EQ(list.back(), 9);
+    ASSERT_THAT(tail, ::testing::ElementsAre(10));
+}
+
+TEST(Splice, InsideNodeSplitsIt) {
+    unrolled_list<int, 4> list = {1, 2, 5, 6};
+    unrolled_list<int, 4> middle = {3, 4};
+    auto iter = list.splice(std::next(list.cbegin(), 2), std::move(middle));
+    ASSERT_EQ(*iter, 3);
+    ASSERT_THAT(list, ::testing::ElementsAre(1, 2, 3, 4, 5, 6));
+    ASSERT_THAT(node_sizes(list), ::testing::ElementsAre(2, 2, 2));
+    ASSERT_EQ(std::as_const(list).end() - std::as_const(list).begin(), 6);
+}
+
+TEST(Splice, EmptyOtherAndEmptyList) {
+    unrolled_list<int, 4> list;
+    unrolled_list<int, 4> empty;
+    ASSERT_EQ(list.splice(list.cend(), std::move(empty)), list.end());
+
+    unrolled_list<int, 4> other = {1, 2};
+    list.splice(list.cend(), std::move(other));
+    ASSERT_THAT(list, ::testing::ElementsAre(1, 2));
+}
+
+TEST(Splice, RejectsSelfAndForeignAllocator) {
+    unrolled_list<int, 4> list = {1, 2};
+    ASSERT_THROW(list.splice(list.cend(), std::move(list)), std::invalid_argument);
+
+    unrolled_list<int, 4, slab_allocator<int>> slab = {1, 2};
+    unrolled_list<int, 4, slab_allocator<int>> foreign = {3};
+    ASSERT_THROW(slab.splice(slab.cend(), std::move(foreign)), std::invalid_argument);
+    ASSERT_THAT(foreign, ::testing::ElementsAre(3));
+}
+
+TEST(Splice, SharedNodesStayCopyOnWrite) {
+    using List = unrolled_list<int, 4, std::allocator<int>, true>;
+    List list = {1, 2};
+    List other = {3, 4};
+    auto snapshot = other.snapshot();
+    list.splice(list.cend(), std::move(other));
+    list.back() = 40;
+    ASSERT_THAT(list, ::testing::ElementsAre(1, 2, 3, 40));
+    ASSERT_THAT(snapshot, ::testing::ElementsAre(3, 4));
+}
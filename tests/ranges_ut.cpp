@@ -0,0 +1,128 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+    Тесты для ranges-интерфейса: конструктор from_range, insert_range / append_range /
+    prepend_range / assign_range и nodes() (обход по нодам).
+*/
+
+TEST(Ranges, FromRangeView) {
+    unrolled_list<int, 4> list(from_range, std::views::iota(0, 10) | std::views::transform([](int i) { return i * i; }));
+    ASSERT_THAT(list, ::testing::ElementsAre(0, 1, 4, 9, 16, 25, 36, 49, 64, 81));
+    ASSERT_EQ(list.size(), 10);
+}
+
+TEST(Ranges, FromRangeInputOnly) {
+    std::istringstream input("1 2 3 4 5");
+    unrolled_list<int, 2> list(from_range, std::views::istream<int>(input));
+    ASSERT_THAT(list, ::testing::ElementsAre(1, 2, 3, 4, 5));
+}
+
+TEST(Ranges, AppendRangePacksNodes) {
+    std::vector<int> source(23);
+    std::iota(source.begin(), source.end(), 0);
+
+    unrolled_list<int, 5> list = {-2, -1};
+    list.append_range(source);
+
+    ASSERT_EQ(list.size(), 25);
+    ASSERT_EQ(list.stats().nodes, 5);
+    ASSERT_EQ(list.back(), 22);
+}
+
+TEST(Ranges, InsertRangeMiddle) {
+    std::list<std::string> std_list = {"a", "b", "c", "d", "e", "f"};
+    unrolled_list<std::string, 4> unrolled_list(from_range, std_list);
+    std::vector<std::string> source = {"x", "y", "z", "w", "v", "u", "t"};
+
+    auto std_it = std::next(std_list.begin(), 3);
+    auto unrolled_it = std::next(unrolled_list.begin(), 3);
+    std_list.insert(std_it, source.begin(), source.end());
+    auto first = unrolled_list.insert_range(unrolled_it, source);
+
+    ASSERT_EQ(*first, "x");
+    ASSERT_THAT(unrolled_list, ::testing::ElementsAreArray(std_list));
+}
+
+TEST(Ranges, PrependAndAssign) {
+    unrolled_list<int, 3> list = {7, 8, 9};
+    list.prepend_range(std::vector<int>{1, 2, 3, 4});
+    ASSERT_THAT(list, ::testing::ElementsAre(1, 2, 3, 4, 7, 8, 9));
+    ASSERT_EQ(list.front(), 1);
+
+    list.assign_range(std::views::iota(0, 4));
+    ASSERT_THAT(list, ::testing::ElementsAre(0, 1, 2, 3));
+}
+
+TEST(Ranges, EmptyRange) {
+    unrolled_list<int, 3> list = {1, 2};
+    auto iter = list.insert_range(list.begin(), std::vector<int>{});
+    ASSERT_EQ(iter, list.begin());
+    ASSERT_THAT(list, ::testing::ElementsAre(1, 2));
+}
+
+namespace {
+
+struct ThrowsOnCopy {
+    static inline int Copies = 0;
+    static inline int Alive = 0;
+    int value;
+
+    ThrowsOnCopy(int v) : value(v) { ++Alive; }
+    ThrowsOnCopy(const ThrowsOnCopy& other) : value(other.value) {
+        if (++Copies == 6) { throw std::runtime_error(""); }
+        ++Alive;
+    }
+    ~ThrowsOnCopy() { --Alive; }
+};
+
+}  // namespace
+
+TEST(Ranges, InsertRangeStrongGuarantee) {
+    std::vector<ThrowsOnCopy> source;
+    source.reserve(8);
+    for (int i = 0; i != 8; ++i) { source.emplace_back(i); }
+    {
+        unrolled_list<ThrowsOnCopy, 3> list;
+        list.push_back(ThrowsOnCopy(100));
+        ThrowsOnCopy::Copies = 0;
+        int alive = ThrowsOnCopy::Alive;
+
+        ASSERT_ANY_THROW(list.append_range(source));
+        ASSERT_EQ(list.size(), 1);
+        ASSERT_EQ(list.front().value, 100);
+        ASSERT_EQ(ThrowsOnCopy::Alive, alive);
+    }
+}
+
+TEST(Ranges, NodeView) {
+    unrolled_list<int, 4> list(from_range, std::views::iota(0, 10));
+    static_assert(std::ranges::bidirectional_range<unrolled_list<int, 4>::node_view>);
+    static_assert(std::ranges::view<unrolled_list<int, 4>::node_view>);
+
+    std::vector<size_t> sizes;
+    int sum = 0;
+    for (std::span<int> chunk : list.nodes()) {
+        sizes.push_back(chunk.size());
+        for (int& value : chunk) { sum += value; }
+    }
+    ASSERT_THAT(sizes, ::testing::ElementsAre(4, 4, 2));
+    ASSERT_EQ(sum, 45);
+
+    auto joined = list.nodes() | std::views::join;
+    ASSERT_TRUE(std::ranges::equal(joined, std::views::iota(0, 10)));
+}
+
+TEST(Ranges, NodeViewEmpty) {
+    const unrolled_list<int, 4> list;
+    ASSERT_TRUE(list.nodes().empty());
+}
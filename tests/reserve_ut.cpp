@@ -0,0 +1,73 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+/*
+    Тесты для reserve() / capacity() / shrink_to_fit():
+    после reserve(n) вставка n элементов в начало или конец не должна выделять память.
+*/
+
+TEST(Reserve, CapacityOfEmptyList) {
+    unrolled_list<int, 4> list;
+    ASSERT_EQ(list.capacity(), 0);
+}
+
+TEST(Reserve, PushBackWithoutAllocations) {
+    unrolled_list<int, 4> list;
+    list.reserve(100);
+    ASSERT_GE(list.capacity() - list.size(), 100);
+
+    auto allocations = list.stats().node_allocations;
+    for (int i = 0; i != 100; ++i) {
+        list.push_back(i);
+    }
+    ASSERT_EQ(list.stats().node_allocations, allocations);
+    ASSERT_EQ(list.size(), 100);
+}
+
+TEST(Reserve, PushFrontWithoutAllocations) {
+    unrolled_list<int, 5> list = {1, 2, 3};
+    list.reserve(50);
+
+    auto allocations = list.stats().node_allocations;
+    for (int i = 0; i != 50; ++i) {
+        list.push_front(i);
+    }
+    ASSERT_EQ(list.stats().node_allocations, allocations);
+    ASSERT_EQ(list.front(), 49);
+    ASSERT_EQ(list.back(), 3);
+}
+
+TEST(Reserve, ReserveIsNotCumulative) {
+    unrolled_list<int, 4> list;
+    list.reserve(8);
+    auto capacity = list.capacity();
+    list.reserve(8);
+    list.reserve(3);
+    ASSERT_EQ(list.capacity(), capacity);
+}
+
+TEST(Reserve, SparesSurviveClear) {
+    unrolled_list<int, 4> list;
+    list.reserve(16);
+    for (int i = 0; i != 10; ++i) {
+        list.push_back(i);
+    }
+    list.clear();
+    auto allocations = list.stats().node_allocations;
+    for (int i = 0; i != 10; ++i) {
+        list.push_back(i);
+    }
+    ASSERT_EQ(list.stats().node_allocations, allocations);
+}
+
+TEST(Reserve, ShrinkToFitReleasesSpares) {
+    unrolled_list<int, 4> list = {1, 2, 3};
+    list.reserve(40);
+    list.shrink_to_fit();
+
+    ASSERT_EQ(list.capacity(), 4);
+    ASSERT_EQ(list.stats().node_frees, 10);
+    ASSERT_THAT(list, ::testing::ElementsAre(1, 2, 3));
+}
@@ -0,0 +1,121 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+    Тесты для find / count / contains / min_element / max_element: результаты
+    (включая позицию первого вхождения) совпадают с алгоритмами std на тех же
+    элементах. Размеры узлов выбраны так, чтобы в узлах были и полные векторные
+    блоки, и хвосты, обрабатываемые поэлементно.
+*/
+
+template<typename T>
+class Search : public testing::Test {
+public:
+    using list_type = unrolled_list<T, 37>;
+
+    static std::vector<T> Values(size_t n, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::vector<T> result;
+        for (size_t i = 0; i != n; ++i) {
+            result.push_back(static_cast<T>(rng() % 50));
+        }
+        return result;
+    }
+
+    static list_type Uneven(const std::vector<T>& values) {
+        list_type list;
+        for (auto iter = values.rbegin(); iter != values.rend(); ++iter) {
+            list.push_front(*iter);  // partly filled nodes
+        }
+        return list;
+    }
+};
+
+using SearchTypes = testing::Types<int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t, float, double, char, bool>;
+TYPED_TEST_SUITE(Search, SearchTypes);
+
+TYPED_TEST(Search, FindAndCountMatchStd) {
+    for (size_t n : {0, 1, 5, 36, 37, 38, 100, 1000}) {
+        auto values = TestFixture::Values(n, static_cast<uint32_t>(n));
+        auto list = TestFixture::Uneven(values);
+        for (int key = 0; key != 52; ++key) {
+            TypeParam value = static_cast<TypeParam>(key);
+            auto expected = std::find(values.begin(), values.end(), value);
+            auto found = std::as_const(list).find(value);
+            ASSERT_EQ(found == list.cend(), expected == values.end());
+            if (expected != values.end()) {
+                ASSERT_EQ(found - list.cbegin(), expected - values.begin());
+            }
+            ASSERT_EQ(list.count(value), static_cast<size_t>(std::count(values.begin(), values.end(), value)));
+            ASSERT_EQ(list.contains(value), expected != values.end());
+        }
+    }
+}
+
+TYPED_TEST(Search, MinMaxMatchStd) {
+    for (size_t n : {1, 2, 31, 33, 64, 500}) {
+        auto values = TestFixture::Values(n, static_cast<uint32_t>(n) + 100);
+        auto list = TestFixture::Uneven(values);
+        ASSERT_EQ(list.min_element() - list.begin(), std::min_element(values.begin(), values.end()) - values.begin());
+        ASSERT_EQ(list.max_element() - list.begin(), std::max_element(values.begin(), values.end()) - values.begin());
+    }
+    typename TestFixture::list_type empty;
+    ASSERT_EQ(empty.min_element(), empty.end());
+    ASSERT_EQ(empty.max_element(), empty.end());
+}
+
+TEST(SearchExtremes, NumericLimits) {
+    unrolled_list<int32_t, 64> list;
+    for (int i = 0; i != 200; ++i) { list.push_back(i); }
+    list.push_back(std::numeric_limits<int32_t>::min());
+    list.push_back(std::numeric_limits<int32_t>::max());
+    ASSERT_EQ(*list.min_element(), std::numeric_limits<int32_t>::min());
+    ASSERT_EQ(*list.max_element(), std::numeric_limits<int32_t>::max());
+
+    unrolled_list<uint32_t, 64> unsigned_list(100, 7u);
+    *(unsigned_list.begin() + 70) = 0xFFFFFFFFu;  // would be -1 if compared as signed
+    ASSERT_EQ(unsigned_list.max_element() - unsigned_list.begin(), 70);
+    ASSERT_EQ(unsigned_list.min_element() - unsigned_list.begin(), 0);
+}
+
+TEST(SearchExtremes, FloatingPointEquality) {
+    unrolled_list<double, 16> list;
+    for (int i = 0; i != 40; ++i) { list.push_back(i + 1.0); }
+    list.push_back(std::nan(""));
+    list.push_back(-0.0);
+    ASSERT_EQ(list.find(std::nan("")), list.end());
+    ASSERT_EQ(list.find(0.0) - list.begin(), 41);
+    ASSERT_EQ(list.count(3.0), 1);
+
+    unrolled_list<float, 16> floats = {2.5f, 1.5f, 1.5f, 3.5f};
+    ASSERT_EQ(floats.min_element() - floats.begin(), 1);
+    ASSERT_EQ(floats.max_element() - floats.begin(), 3);
+}
+
+TEST(SearchExtremes, NonArithmetic) {
+    unrolled_list<std::string, 3> list = {"b", "a", "c", "a", "d"};
+    ASSERT_EQ(list.find("a") - list.begin(), 1);
+    ASSERT_EQ(list.count("a"), 2);
+    ASSERT_FALSE(list.contains("z"));
+    ASSERT_EQ(*list.min_element(), "a");
+    ASSERT_EQ(*list.max_element(), "d");
+}
+
+TEST(SearchExtremes, FoundIteratorIsWritable) {
+    unrolled_list<int, 8, std::allocator<int>, true> list = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto snap = list.snapshot();
+    *list.find(5) = 50;
+    *list.min_element() = -1;
+    ASSERT_THAT(list, testing::ElementsAre(-1, 2, 3, 4, 50, 6, 7, 8, 9));
+    ASSERT_THAT(snap, testing::ElementsAre(1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
@@ -0,0 +1,137 @@
+#include <unrolled_list.h>
+#include <slab_allocator.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <list>
+#include <vector>
+
+/*
+    Тесты для slab_allocator: выдача объектов из одного слэба, учёт подсказки (hint),
+    возврат слэба после освобождения всех его объектов и работа unrolled_list поверх него.
+*/
+
+TEST(SlabAllocator, ObjectsShareSlab) {
+    slab_allocator<int, 8> allocator;
+    int* first = allocator.allocate(1);
+    int* second = allocator.allocate(1, first);
+
+    ASSERT_EQ(allocator.slab_count(), 1);
+    ASSERT_LT(std::abs(second - first), static_cast<std::ptrdiff_t>(allocator.objects_per_slab()));
+
+    allocator.deallocate(first, 1);
+    allocator.deallocate(second, 1);
+    ASSERT_EQ(allocator.slab_count(), 0);
+}
+
+TEST(SlabAllocator, HintPicksNeighbourSlab) {
+    slab_allocator<int, 4> allocator;
+    const size_t per_slab = allocator.objects_per_slab();
+    int* objects[64];
+    ASSERT_LT(per_slab + 2, std::size(objects));
+
+    for (size_t i = 0; i != per_slab + 1; ++i) { objects[i] = allocator.allocate(1); }  // first slab is full
+    ASSERT_EQ(allocator.slab_count(), 2);
+
+    int* freed = objects[1];
+    allocator.deallocate(freed, 1);  // both slabs have room now, the first one is preferred without a hint
+    objects[per_slab + 1] = allocator.allocate(1, objects[per_slab]);
+    ASSERT_NE(objects[per_slab + 1], freed);
+    objects[1] = allocator.allocate(1, objects[0]);
+    ASSERT_EQ(objects[1], freed);
+    ASSERT_EQ(allocator.slab_count(), 2);
+
+    for (size_t i = 0; i != per_slab + 2; ++i) { allocator.deallocate(objects[i], 1); }
+    ASSERT_EQ(allocator.slab_count(), 0);
+}
+
+TEST(SlabAllocator, CopiesShareThePool) {
+    slab_allocator<int> allocator;
+    slab_allocator<int> copy = allocator;
+    slab_allocator<int> other;
+
+    ASSERT_EQ(allocator, copy);
+    ASSERT_NE(allocator, other);
+
+    int* p = allocator.allocate(1);
+    ASSERT_EQ(copy.slab_count(), 1);
+    copy.deallocate(p, 1);
+    ASSERT_EQ(allocator.slab_count(), 0);
+}
+
+TEST(SlabAllocator, BulkRequestsBypassSlabs) {
+    slab_allocator<int> allocator;
+    int* p = allocator.allocate(100);
+    ASSERT_EQ(allocator.slab_count(), 0);
+    allocator.deallocate(p, 100);
+}
+
+TEST(SlabAllocator, UnrolledListMixedOperations) {
+    std::list<int> std_list;
+    unrolled_list<int, 4, slab_allocator<int, 8>> unrolled_list;
+
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 3 == 0) {
+            std_list.push_front(i);
+            unrolled_list.push_front(i);
+        } else if (i % 3 == 1) {
+            std_list.push_back(i);
+            unrolled_list.push_back(i);
+        } else {
+            auto std_it = std_list.begin();
+            auto unrolled_it = unrolled_list.begin();
+            std::advance(std_it, std_list.size() / 2);
+            std::advance(unrolled_it, std_list.size() / 2);
+            std_list.insert(std_it, i);
+            unrolled_list.insert(unrolled_it, i);
+        }
+    }
+    ASSERT_THAT(unrolled_list, ::testing::ElementsAreArray(std_list));
+
+    for (int i = 0; i < 700; ++i) {
+        std_list.pop_front();
+        unrolled_list.pop_front();
+    }
+    ASSERT_THAT(unrolled_list, ::testing::ElementsAreArray(std_list));
+}
+
+TEST(SlabAllocator, SwapKeepsOwnership) {
+    unrolled_list<int, 2, slab_allocator<int>> lhs = {1, 2, 3, 4, 5};
+    unrolled_list<int, 2, slab_allocator<int>> rhs = {6, 7, 8};
+    lhs.swap(rhs);
+    lhs.clear();
+    rhs.clear();
+
+    ASSERT_TRUE(lhs.empty());
+    ASSERT_TRUE(rhs.empty());
+}
+
+TEST(SlabAllocator, RebindSharesThePools) {
+    struct wide { char bytes[64]; };
+    slab_allocator<int> allocator;
+    slab_allocator<wide> rebound(allocator);
+    ASSERT_EQ(slab_allocator<int>(rebound), allocator);
+    ASSERT_EQ(rebound, allocator);
+
+    // double has int's slot (both hold the free-list pointer), so it allocates from the same pool
+    slab_allocator<double> same_slot(rebound);
+    double* p = same_slot.allocate(1);
+    ASSERT_EQ(allocator.slab_count(), 1);
+    ASSERT_EQ(rebound.slab_count(), 0);
+    same_slot.deallocate(p, 1);
+    ASSERT_EQ(allocator.slab_count(), 0);
+}
+
+TEST(SlabAllocator, ListsBuiltFromOneAllocatorShareNodes) {
+    using list_type = unrolled_list<int, 4, slab_allocator<int>>;
+    slab_allocator<int> allocator;
+    list_type source({1, 2, 3, 4, 5}, allocator);
+    list_type target(from_range, std::vector<int>{7}, allocator);
+
+    target.insert_node(target.cbegin(), source.extract_front_node());
+    ASSERT_THAT(target, ::testing::ElementsAre(1, 2, 3, 4, 7));
+    target.splice(target.cend(), std::move(source));
+    ASSERT_THAT(target, ::testing::ElementsAre(1, 2, 3, 4, 7, 5));
+    ASSERT_TRUE(source.empty());
+}
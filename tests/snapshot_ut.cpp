@@ -0,0 +1,229 @@
+#include <unrolled_list.h>
+#include <slab_allocator.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+    Тесты для snapshot() (списки с параметром Snapshots = true): снимок разделяет узлы со списком без копирования элементов,
+    а изменение списка копирует только затронутый узел. Снимок не видит последующих
+    изменений, переживает список и может читаться из другого потока.
+*/
+
+namespace {
+
+template<typename T, size_t NodeMaxSize = 10, typename Allocator = std::allocator<T>>
+using SharedList = unrolled_list<T, NodeMaxSize, Allocator, true>;
+
+template<typename List>
+concept TakesSnapshots = requires(List& list) { list.snapshot(); };
+
+struct Counted {
+    static inline int copies = 0;
+    static inline int alive = 0;
+    static inline int copies_left = 0;  // the copy that brings it to 0 throws
+
+    Counted(int v) : value(v) { ++alive; }
+    Counted(const Counted& other) : value(other.value) {
+        if (copies_left > 0 && --copies_left == 0) { throw std::runtime_error("copy failed"); }
+        ++copies;
+        ++alive;
+    }
+    ~Counted() { --alive; }
+
+    bool operator==(const Counted& other) const { return value == other.value; }
+
+    int value;
+};
+
+template<typename Range>
+std::vector<int> Values(const Range& range) {
+    std::vector<int> result;
+    for (const auto& element : range) { result.push_back(element.value); }
+    return result;
+}
+
+std::vector<int> Iota(int from, int to) {
+    std::vector<int> result;
+    for (int i = from; i != to; ++i) { result.push_back(i); }
+    return result;
+}
+
+}  // namespace
+
+TEST(Snapshot, SharesNodesWithoutCopies) {
+    SharedList<Counted, 4> list;
+    for (int i = 0; i != 20; ++i) { list.push_back(i); }
+
+    Counted::copies = 0;
+    auto snap = list.snapshot();
+    ASSERT_EQ(Counted::copies, 0);
+    ASSERT_EQ(snap.size(), 20);
+    ASSERT_EQ(Values(snap), Iota(0, 20));
+    ASSERT_EQ(snap.front().value, 0);
+    ASSERT_EQ(snap.back().value, 19);
+}
+
+TEST(Snapshot, WriteCopiesOnlyTheTouchedNode) {
+    SharedList<Counted, 4> list;
+    for (int i = 0; i != 20; ++i) { list.push_back(i); }
+    auto snap = list.snapshot();
+
+    Counted::copies = 0;
+    list.push_back(20);  // the last node is full: a new node, nothing shared is touched
+    ASSERT_EQ(Counted::copies, 1);
+
+    Counted::copies = 0;
+    list.pop_front();  // the first node is copied, then shifted
+    ASSERT_LE(Counted::copies, 4 + 3);
+
+    Counted::copies = 0;
+    list.pop_front();  // already private
+    ASSERT_LE(Counted::copies, 2);
+
+    ASSERT_EQ(Values(snap), Iota(0, 20));
+    ASSERT_EQ(Values(list), Iota(2, 21));
+}
+
+TEST(Snapshot, ImmuneToEveryKindOfWrite) {
+    SharedList<int, 3> list;
+    for (int i = 0; i != 30; ++i) { list.push_back(i); }
+    auto snap = list.snapshot();
+    std::vector<int> expected(snap.begin(), snap.end());
+
+    list.front() = -1;
+    list.back() = -2;
+    auto iter = list.cbegin();
+    for (int i = 0; i != 10; ++i) { ++iter; }
+    list.insert(iter, 100);
+    list.erase(list.cbegin());
+    list.insert_range(list.cend(), std::vector<int>{7, 8, 9});
+    list.extract_front_node();
+    for (int& value : list) { value *= 10; }  // non-const begin() unshares the rest
+
+    ASSERT_EQ(std::vector<int>(snap.begin(), snap.end()), expected);
+
+    auto cursor = list.make_cursor();
+    auto snap2 = list.snapshot();
+    std::vector<int> expected2(snap2.begin(), snap2.end());
+    *cursor.at(5) = 12345;
+    ASSERT_EQ(std::vector<int>(snap2.begin(), snap2.end()), expected2);
+    ASSERT_EQ(*cursor.at(5), 12345);
+}
+
+TEST(Snapshot, RangeEraseUnsharesBothEndsFirst) {
+    SharedList<Counted, 4> list;
+    for (int i = 0; i != 12; ++i) { list.push_back(i); }
+    auto snap = list.snapshot();
+
+    // the first node is copied, then the last one (4 + 4): fail while copying the last one
+    Counted::copies_left = 7;
+    ASSERT_THROW(list.erase(std::next(list.cbegin(), 2), std::next(list.cbegin(), 9)), std::runtime_error);
+    Counted::copies_left = 0;
+    ASSERT_EQ(list.size(), 12);
+    ASSERT_EQ(Values(list), Iota(0, 12));
+
+    list.erase(std::next(list.cbegin(), 2), std::next(list.cbegin(), 9));
+    ASSERT_EQ(Values(list), (std::vector<int>{0, 1, 9, 10, 11}));
+    ASSERT_EQ(Values(snap), Iota(0, 12));
+}
+
+TEST(Snapshot, OutlivesListAndReleasesNodes) {
+    Counted::alive = 0;
+    {
+        SharedList<Counted, 4>::snapshot_type snap;
+        {
+            SharedList<Counted, 4> list;
+            for (int i = 0; i != 10; ++i) { list.push_back(i); }
+            snap = list.snapshot();
+            auto copy = snap;
+            list.clear();
+            ASSERT_EQ(Counted::alive, 10);
+            list.push_back(42);
+        }
+        ASSERT_EQ(Values(snap), Iota(0, 10));
+        ASSERT_EQ(Counted::alive, 10);
+    }
+    ASSERT_EQ(Counted::alive, 0);
+}
+
+TEST(Snapshot, ListReclaimsNodesAfterSnapshotDies) {
+    Counted::alive = 0;
+    SharedList<Counted, 4> list;
+    for (int i = 0; i != 8; ++i) { list.push_back(i); }
+    {
+        auto snap = list.snapshot();
+    }
+    Counted::copies = 0;
+    list.pop_back();  // the snapshot is gone, the node is modified in place
+    ASSERT_EQ(Counted::copies, 0);
+    list.clear();
+    ASSERT_EQ(Counted::alive, 0);
+}
+
+TEST(Snapshot, OnlyForListsWithSnapshots) {
+    using Plain = unrolled_list<int, 4>;
+    static_assert(!std::is_default_constructible_v<Plain::snapshot_type>);
+    static_assert(!std::is_copy_constructible_v<Plain::snapshot_type>);
+    static_assert(!std::is_destructible_v<Plain::snapshot_type>);
+    static_assert(!TakesSnapshots<Plain>);
+
+    using Shared = SharedList<int, 4>;
+    static_assert(TakesSnapshots<Shared>);
+    static_assert(std::is_nothrow_move_constructible_v<Shared::snapshot_type>);
+    std::vector<Shared::snapshot_type> snapshots;
+    Shared list = {1, 2, 3};
+    snapshots.push_back(list.snapshot());
+    snapshots.push_back(snapshots.front());
+    list.clear();
+    ASSERT_THAT(snapshots.back(), testing::ElementsAre(1, 2, 3));
+}
+
+TEST(Snapshot, EmptyList) {
+    SharedList<int> list;
+    auto snap = list.snapshot();
+    ASSERT_TRUE(snap.empty());
+    ASSERT_EQ(snap.begin(), snap.end());
+    list.push_back(1);
+    ASSERT_TRUE(snap.empty());
+}
+
+TEST(Snapshot, SlabAllocator) {
+    SharedList<int, 4, slab_allocator<int>> list = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto snap = list.snapshot();
+    list.clear();
+    list.push_back(10);
+    ASSERT_THAT(snap, testing::ElementsAre(1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST(Snapshot, ConcurrentReaders) {
+    SharedList<int, 8> list;
+    for (int i = 0; i != 4000; ++i) { list.push_back(i); }
+
+    std::atomic<bool> failed = false;
+    std::vector<std::thread> readers;
+    for (int round = 0; round != 8; ++round) {
+        readers.emplace_back([snap = list.snapshot(), &failed] {
+            long long sum = 0;
+            size_t count = 0;
+            for (int value : snap) { sum += value; ++count; }
+            if (count != snap.size() || snap.front() < 0) { failed = true; }
+            (void)sum;
+        });
+        for (int i = 0; i != 300; ++i) {
+            list.pop_front();
+            list.push_back(-i);
+        }
+        auto iter = list.cbegin();
+        for (int i = 0; i != 100; ++i) { ++iter; }
+        list.insert(iter, -1);
+    }
+    for (auto& reader : readers) { reader.join(); }
+    ASSERT_FALSE(failed);
+}
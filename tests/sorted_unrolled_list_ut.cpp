@@ -0,0 +1,189 @@
+#include <unrolled_list.h>
+#include <sorted_unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+    Тесты для sorted_unrolled_list: после любых вставок и удалений элементы
+    упорядочены, а lower_bound/upper_bound/find совпадают с std::lower_bound и т.п.
+    на отсортированном векторе. Используются маленькие узлы, чтобы было много
+    разбиений и освобождений узлов.
+*/
+
+namespace {
+
+template<typename List>
+std::vector<typename List::value_type> Contents(const List& list) {
+    return {list.begin(), list.end()};
+}
+
+}  // namespace
+
+TEST(SortedUnrolledList, InsertKeepsOrder) {
+    sorted_unrolled_list<int, std::less<int>, 4> list;
+    std::vector<int> expected;
+    std::mt19937 rng(7);
+    for (int i = 0; i != 500; ++i) {
+        int value = static_cast<int>(rng() % 200);
+        auto iter = list.insert(value);
+        ASSERT_EQ(*iter, value);
+        expected.insert(std::upper_bound(expected.begin(), expected.end(), value), value);
+    }
+    ASSERT_EQ(list.size(), expected.size());
+    ASSERT_EQ(Contents(list), expected);
+}
+
+TEST(SortedUnrolledList, DescendingInsertsGoInFrontOfFullNodes) {
+    sorted_unrolled_list<int, std::less<int>, 4> list;
+    for (int value = 40; value != 0; --value) {
+        list.insert(value);
+        ASSERT_EQ(list.lower_bound(value), list.begin());
+        ASSERT_EQ(list.upper_bound(40), list.end());
+    }
+    std::vector<int> expected(40);
+    std::iota(expected.begin(), expected.end(), 1);
+    ASSERT_EQ(Contents(list), expected);
+    for (int key = 1; key <= 40; ++key) {
+        ASSERT_EQ(list.find(key) - list.begin(), key - 1);
+    }
+}
+
+TEST(SortedUnrolledList, Bounds) {
+    sorted_unrolled_list<int, std::less<int>, 5> list;
+    std::vector<int> expected;
+    for (int i = 0; i != 300; ++i) {
+        int value = (i * 37) % 101;  // every value in [0, 101) about three times
+        list.insert(value);
+        expected.insert(std::upper_bound(expected.begin(), expected.end(), value), value);
+    }
+    for (int key = -2; key != 105; ++key) {
+        auto lower = std::lower_bound(expected.begin(), expected.end(), key) - expected.begin();
+        auto upper = std::upper_bound(expected.begin(), expected.end(), key) - expected.begin();
+        ASSERT_EQ(list.lower_bound(key) - list.begin(), lower) << key;
+        ASSERT_EQ(list.upper_bound(key) - list.begin(), upper) << key;
+        ASSERT_EQ(list.count(key), static_cast<size_t>(upper - lower)) << key;
+        ASSERT_EQ(list.contains(key), upper != lower) << key;
+        if (upper != lower) {
+            ASSERT_EQ(*list.find(key), key);
+        } else {
+            ASSERT_EQ(list.find(key), list.end());
+        }
+    }
+}
+
+TEST(SortedUnrolledList, EmptyList) {
+    sorted_unrolled_list<int> list;
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.lower_bound(1), list.end());
+    ASSERT_EQ(list.upper_bound(1), list.end());
+    ASSERT_FALSE(list.contains(1));
+    ASSERT_EQ(list.erase(1), 0);
+}
+
+TEST(SortedUnrolledList, EraseUntilEmpty) {
+    sorted_unrolled_list<int, std::less<int>, 3> list;
+    std::vector<int> expected;
+    for (int i = 0; i != 200; ++i) {
+        list.insert(i % 50);
+        expected.push_back(i % 50);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    std::mt19937 rng(11);
+    while (!expected.empty()) {
+        int key = expected[rng() % expected.size()];
+        auto iter = list.find(key);
+        ASSERT_NE(iter, list.end());
+        auto next = list.erase(iter);
+        auto pos = std::lower_bound(expected.begin(), expected.end(), key);
+        pos = expected.erase(pos);
+        if (pos == expected.end()) {
+            ASSERT_EQ(next, list.end());
+        } else {
+            ASSERT_EQ(*next, *pos);
+        }
+        ASSERT_EQ(list.size(), expected.size());
+        ASSERT_EQ(list.lower_bound(key) - list.begin(), std::lower_bound(expected.begin(), expected.end(), key) - expected.begin());
+    }
+    ASSERT_TRUE(list.empty());
+    list.insert(5);
+    ASSERT_EQ(Contents(list), std::vector<int>{5});
+}
+
+TEST(SortedUnrolledList, EraseKeyAndRange) {
+    sorted_unrolled_list<int, std::less<int>, 4> list = {5, 1, 3, 3, 3, 3, 3, 3, 2, 4, 3};
+    ASSERT_EQ(list.erase(3), 7);
+    ASSERT_EQ(Contents(list), (std::vector<int>{1, 2, 4, 5}));
+    ASSERT_EQ(list.erase(3), 0);
+
+    auto iter = list.erase(list.lower_bound(2), list.upper_bound(4));
+    ASSERT_EQ(*iter, 5);
+    ASSERT_EQ(Contents(list), (std::vector<int>{1, 5}));
+}
+
+TEST(SortedUnrolledList, CustomCompare) {
+    sorted_unrolled_list<std::string, std::greater<std::string>, 3> list = {"b", "d", "a", "c", "e"};
+    ASSERT_EQ(Contents(list), (std::vector<std::string>{"e", "d", "c", "b", "a"}));
+    ASSERT_EQ(*list.lower_bound("bb"), "b");
+}
+
+TEST(SortedUnrolledList, MergeAppendsTail) {
+    sorted_unrolled_list<int, std::less<int>, 4> list = {1, 2, 3};
+    std::vector<int> batch = {3, 4, 5, 6, 7, 8, 9, 10, 11};
+    list.merge(batch);
+    ASSERT_EQ(Contents(list), (std::vector<int>{1, 2, 3, 3, 4, 5, 6, 7, 8, 9, 10, 11}));
+    ASSERT_EQ(*list.lower_bound(9), 9);
+    list.insert(0);
+    list.insert(12);
+    ASSERT_EQ(list.front(), 0);
+    ASSERT_EQ(list.back(), 12);
+}
+
+TEST(SortedUnrolledList, MergeLargeAndSmallBatches) {
+    sorted_unrolled_list<int, std::less<int>, 6> list;
+    std::vector<int> expected;
+    std::mt19937 rng(3);
+    for (size_t batch_size : {50, 3, 200, 1, 20}) {
+        std::vector<int> batch;
+        for (size_t i = 0; i != batch_size; ++i) {
+            batch.push_back(static_cast<int>(rng() % 1000));
+        }
+        std::sort(batch.begin(), batch.end());
+        list.merge(batch);
+        expected.insert(expected.end(), batch.begin(), batch.end());
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(Contents(list), expected);
+        for (int key = 0; key < 1000; key += 17) {
+            ASSERT_EQ(list.lower_bound(key) - list.begin(), std::lower_bound(expected.begin(), expected.end(), key) - expected.begin());
+        }
+    }
+}
+
+TEST(SortedUnrolledList, CopyAndMove) {
+    sorted_unrolled_list<int, std::less<int>, 3> list = {4, 2, 8, 6, 1, 9, 7};
+    auto copy = list;
+    copy.insert(5);
+    ASSERT_EQ(Contents(list), (std::vector<int>{1, 2, 4, 6, 7, 8, 9}));
+    ASSERT_EQ(Contents(copy), (std::vector<int>{1, 2, 4, 5, 6, 7, 8, 9}));
+
+    auto moved = std::move(copy);
+    ASSERT_TRUE(copy.empty());
+    moved.insert(3);
+    ASSERT_EQ(*moved.find(3), 3);
+    copy.insert(1);
+    ASSERT_EQ(Contents(copy), std::vector<int>{1});
+
+    list = moved;
+    ASSERT_TRUE(list == moved);
+    list.erase(5);
+    ASSERT_FALSE(list == moved);
+    ASSERT_FALSE(list.contains(5));
+}
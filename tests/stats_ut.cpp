@@ -0,0 +1,58 @@
+#include <unrolled_list.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+/*
+    Тесты проверяют счётчики stats(): количество нод, гистограмму заполненности
+    и счётчики split / освобождений нод / перемещений элементов.
+*/
+
+TEST(Stats, EmptyList) {
+    unrolled_list<int, 4> list;
+    auto stats = list.stats();
+
+    ASSERT_EQ(stats.nodes, 0);
+    ASSERT_EQ(stats.bytes_used, 0);
+    ASSERT_EQ(stats.payload_bytes, 0);
+    ASSERT_EQ(stats.splits, 0);
+    ASSERT_EQ(stats.node_allocations, 0);
+}
+
+TEST(Stats, PushBackFillsNodes) {
+    unrolled_list<int, 4> list;
+    for (int i = 0; i != 10; ++i) {
+        list.push_back(i);
+    }
+    auto stats = list.stats();
+
+    ASSERT_EQ(stats.nodes, 3);
+    ASSERT_EQ(stats.fill_histogram[decltype(stats)::histogram_buckets - 1], 2);  // two full nodes
+    ASSERT_EQ(stats.fill_histogram[5], 1);                                       // 2 of 4
+    ASSERT_EQ(stats.splits, 2);
+    ASSERT_EQ(stats.node_allocations, 3);
+    ASSERT_EQ(stats.element_moves, 0);
+    ASSERT_EQ(stats.payload_bytes, 10 * sizeof(int));
+    ASSERT_GT(stats.bytes_used, stats.payload_bytes);
+    ASSERT_EQ(stats.bytes_allocated, stats.bytes_used);
+}
+
+TEST(Stats, PushFrontCountsMoves) {
+    unrolled_list<int, 4> list;
+    for (int i = 0; i != 4; ++i) {
+        list.push_front(i);
+    }
+
+    ASSERT_EQ(list.stats().element_moves, 0 + 1 + 2 + 3);
+}
+
+TEST(Stats, EraseCountsFreesAndMoves) {
+    unrolled_list<int, 4> list = {1, 2, 3, 4, 5};
+    list.pop_front();
+    ASSERT_EQ(list.stats().element_moves, 3);
+
+    list.pop_back();
+    auto stats = list.stats();
+    ASSERT_EQ(stats.node_frees, 1);
+    ASSERT_EQ(stats.nodes, 1);
+}